@@ -7,16 +7,133 @@
  * Written by: Andrew Hankins
  */
 
+// Include guard for CDA.cpp
+#ifndef CDA_CPP
+#define CDA_CPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ErrorPolicy.cpp"
+#include "InitTracker.cpp"
+#include "IntroSelect.cpp"
+#include "KWayMerge.cpp"
+#include "MergeSort.cpp"
+#include "ParallelSort.cpp"
+#include "RadixSort.cpp"
+#include "SearchIndex.cpp"
+#include "SimdScan.cpp"
 
 using namespace std;
 
-template <typename elmtype>
+/**
+ * Capacity policy that allows the #CDA to have any capacity. Indexes are wrapped around the end of
+ * the array with a modulo, so constructors that are given an exact size allocate exactly that size.
+ */
+struct GeneralCapacity
+{
+    /**
+     * Computes the capacity that should be allocated for a requested size.
+     *
+     * @param[in] s The requested size of the array.
+     *
+     * @return The capacity to allocate, which is always s.
+     */
+    static int RoundCapacity(int s)
+    {
+        return s;
+    }
+
+    /**
+     * Wraps an index around the end of the array.
+     *
+     * @param[in] idx      A non-negative index that may be past the end of the array.
+     * @param[in] capacity The capacity of the array.
+     *
+     * @return The index wrapped into the range [0, capacity).
+     */
+    static int Wrap(int idx, int capacity)
+    {
+        return idx % capacity;
+    }
+};
+
+/**
+ * Capacity policy that keeps the capacity of the #CDA a power of two. Indexes can then be wrapped
+ * around the end of the array with a mask instead of an integer division.
+ */
+struct PowerOfTwoCapacity
+{
+    /**
+     * Computes the capacity that should be allocated for a requested size.
+     *
+     * @param[in] s The requested size of the array.
+     *
+     * @return The smallest power of two that is greater than or equal to s.
+     */
+    static int RoundCapacity(int s)
+    {
+        int capacity = 1;
+
+        while (capacity < s)
+        {
+            capacity <<= 1;
+        }
+
+        return capacity;
+    }
+
+    /**
+     * Wraps an index around the end of the array.
+     *
+     * @param[in] idx      A non-negative index that may be past the end of the array.
+     * @param[in] capacity The capacity of the array, which must be a power of two.
+     *
+     * @return The index wrapped into the range [0, capacity).
+     */
+    static int Wrap(int idx, int capacity)
+    {
+        return idx & (capacity - 1);
+    }
+};
+
+/**
+ * Settings that control when the #CDA grows and shrinks. The defaults double the array when it is
+ * full, and halve it when it is 25% full, without going below a capacity of 4.
+ */
+struct ResizePolicy
+{
+    double growth_factor;  ///< The capacity is multiplied by this when the array is full.
+    int    shrink_divisor; ///< The array is halved once only 1 / shrink_divisor of it is in use, at least 2.
+    int    min_capacity;   ///< The array is never shrunk below this capacity.
+    bool   b_shrink;       ///< Set to false to never shrink the array when elements are deleted.
+
+    ResizePolicy() : growth_factor(2.0), shrink_divisor(4), min_capacity(4), b_shrink(true)
+    {
+    }
+};
+
+template <typename elmtype, typename capacity_policy = GeneralCapacity, typename init_tracker = SplitInitTracker,
+          typename error_policy = PrintOnError>
 
 class CDA
 {
+    static_assert(alignof(elmtype) <= alignof(max_align_t), "CDA storage is not aligned for this type");
+
     private:
 
+        static const int batch_group = 16; ///< The number of searches #BinSearchBatch() advances in lockstep.
+
         int user_size    = 0;         ///< The size of the #data_array that the user has access to.
         int arr_capacity = 0;         ///< The total storage allocated for the #data_array.
 
@@ -25,165 +142,198 @@ class CDA
 
         bool b_init      = false;     ///< Used to signal if the array should be treated as initialized.
         elmtype init_val;             ///< The value that the array should be initialzed to.
-        int elms_changed = 0;         ///< The number of elements that have been changed of the init array.
+        init_tracker tracker;         ///< Records which slots have been changed when the array is treated as initialized.
 
-        elmtype ref_val;              ///< Reference value for the operator function
+        elmtype ref_val;              ///< Reference value returned when the #error_policy rejects an index
 
-        elmtype * data_array  = NULL; ///< A pointer to the array where the data will be stored.
-        int     * idx_array   = NULL; ///< A pointer to the array where the indexes of the #point_array will be stored.
-        int     * point_array = NULL; ///< A pointer to the array where the indexes of the #idx_array will be stored.
+        ResizePolicy resize_policy;   ///< When the array grows and shrinks.
+        int reserved_capacity = 0;    ///< The capacity asked for by #Reserve(), which the array won't shrink below.
 
-    public:
+        elmtype * data_array  = NULL; ///< A pointer to the raw storage where the data will be stored.
 
         /**
-         * The default constructor, sets the arr_capacity to 1, and user_size to 0.
+         * Wraps an index around the end of the #data_array using the #capacity_policy.
          *
-         * Runs in O(1) time
+         * @param[in] idx A non-negative index that may be past the end of the #data_array.
+         *
+         * @return The index of the #data_array that idx refers to.
          */
-        CDA(void)
+        int WrapIdx(int idx) const
         {
-            // The array has a capacity of 1, but the user has not added any elements.
-            user_size    = 0;
-            arr_capacity = 1;
-
-            // The array has not been initialized
-            b_init = false;
+            return capacity_policy::Wrap(idx, arr_capacity);
+        }
 
-            // No elements have been added so the front and back are both at idx 0.
-            front_idx = 0;
-            back_idx  = 0;
+        /**
+         * Adds the index of each match found by #FindAll() to the output array.
+         */
+        template <typename out_policy>
+        struct FindAllVisitor
+        {
+            CDA<int, out_policy> * out;    ///< The array that the indexes are added to.
+            int                    offset; ///< The index of the first element of the segment.
 
-            // Allocates an array of size 1.
-            data_array  = new elmtype[1];
-            idx_array   = NULL;
-            point_array = NULL;
-        }
+            void operator()(int idx)
+            {
+                out->AddEnd(offset + idx);
+            }
+        };
 
         /**
-         * Constructor that creates an array of #user_size s and #arr_capacity s.
+         * Takes the arrays and attributes of another CDA object, leaving it empty with a capacity of 0.
          *
-         * @param[in] s The value used to initialize user_size and arr_capacity.
+         * @param[in] obj_being_moved The CDA object to take the arrays from.
          */
-        CDA(int s)
+        void TakeArrays(CDA & obj_being_moved)
         {
-            // The user_size and arr_capcity variable should match.
-            user_size    = s;
-            arr_capacity = s;
+            user_size    = obj_being_moved.user_size;
+            arr_capacity = obj_being_moved.arr_capacity;
 
-            // The array has not been initialized.
-            b_init = false;
+            front_idx = obj_being_moved.front_idx;
+            back_idx  = obj_being_moved.back_idx;
 
-            // Array is full so both indexes should be set to 0.
-            front_idx = 0;
-            back_idx  = 0;
+            b_init       = obj_being_moved.b_init;
+            init_val     = move(obj_being_moved.init_val);
+
+            data_array = obj_being_moved.data_array;
+            tracker.Take(obj_being_moved.tracker);
 
-            // Allocates an array of size s.
-            data_array  = new elmtype[s];
-            idx_array   = NULL;
-            point_array = NULL;
+            resize_policy     = obj_being_moved.resize_policy;
+            reserved_capacity = obj_being_moved.reserved_capacity;
+
+            // Leave the other object as an empty array that can still be used
+            obj_being_moved.user_size    = 0;
+            obj_being_moved.arr_capacity = 0;
+            obj_being_moved.front_idx    = 0;
+            obj_being_moved.back_idx     = 0;
+            obj_being_moved.b_init       = false;
+            obj_being_moved.data_array   = NULL;
+            obj_being_moved.reserved_capacity = 0;
         }
 
         /**
-         * Constructor that creates an array of #user_size s and #arr_capacity s. The array created
-         * should act as though it has been initialized with the value init, but it should still be
-         * in O(1) time.
+         * Allocates raw storage for the #data_array. No elements are constructed.
          *
-         * @param[in] s    The value used to initialize the #user_size and #arr_capacity.
-         * @param[in] init The value that the array should act as though it has been initialized with.
+         * @param[in] capacity The number of elements the storage should have room for.
+         *
+         * @return A pointer to the storage.
          */
-        CDA(int s, elmtype init)
+        static elmtype * Allocate(int capacity)
         {
-            // Variables specific to the initialized array
-            b_init             = true;
-            init_val           = init;
-            elms_changed       = 0;
-
-            // User size and capacity should both be equal to the size of the array.
-            user_size    = s;
-            arr_capacity = s;
-
-            // Array is full so the indexes should be equal to each other.
-            front_idx = 0;
-            back_idx  = 0;
-
-            // The data array as well as the two arrays needed to initialize an array in constant time.
-            // All should be of size s.
-            data_array  = new elmtype[s];
-            idx_array   = new int[s];
-            point_array = new int[s];
+            return static_cast<elmtype *>(::operator new(capacity * sizeof(elmtype)));
         }
 
         /**
-         * Copy Assignment operator.
+         * Frees storage that was allocated with #Allocate(). Any elements in it must already have been
+         * destroyed.
          *
-         * @param[in] obj_being_copied A reference to a CDA object that is going to be copied over.
+         * @param[in] storage The storage to free, or NULL.
+         */
+        static void Deallocate(elmtype * storage)
+        {
+            ::operator delete(static_cast<void *>(storage));
+        }
+
+        /**
+         * Moves elements from one array to raw storage and destroys the originals, using memcpy for
+         * trivially copyable types.
          *
-         *@return A reference to an updated CDA object that matches #obj_being_copied.
+         * @param[in]  src  The elements to move.
+         * @param[in]  n    The number of elements to move.
+         * @param[out] dest The raw storage to move the elements to, which must not overlap src.
          */
-        CDA& operator=(const CDA &obj_being_copied)
+        static void RelocateElements(elmtype * src, int n, elmtype * dest)
         {
-            // Must delete any prior data before copying new data over.
-            if (NULL != data_array)
-            {
-                delete[] data_array;
-                data_array = NULL;
-            }
-            if (NULL != idx_array)
+            RelocateElementsImpl(src, n, dest, integral_constant<bool, is_trivially_copyable<elmtype>::value>());
+        }
+
+        static void RelocateElementsImpl(elmtype * src, int n, elmtype * dest, true_type)
+        {
+            if (n > 0)
             {
-                delete[] idx_array;
-                idx_array = NULL;
+                memcpy(static_cast<void *>(dest), static_cast<const void *>(src), n * sizeof(elmtype));
             }
-            if (NULL != point_array)
+        }
+
+        static void RelocateElementsImpl(elmtype * src, int n, elmtype * dest, false_type)
+        {
+            for (int idx = 0; idx < n; idx++)
             {
-                delete[] point_array;
-                idx_array = NULL;
+                ::new (static_cast<void *>(dest + idx)) elmtype(move(src[idx]));
+                src[idx].~elmtype();
             }
+        }
 
-            // Update the local class attributes
-            user_size    = obj_being_copied.user_size;
-            arr_capacity = obj_being_copied.arr_capacity;
+        /**
+         * Moves the elements of the array into raw storage, one segment at a time.
+         *
+         * @param[out] dest The storage to move into, which must have room for #user_size elements.
+         *
+         * @note Should only be used when the array is not being treated as initialized.
+         */
+        void RelocateSegmentsTo(elmtype * dest)
+        {
+            int const first_len  = min(user_size, arr_capacity - front_idx);
+            int const second_len = user_size - first_len;
 
-            front_idx = obj_being_copied.front_idx;
-            back_idx  = obj_being_copied.back_idx;
+            RelocateElements(data_array + front_idx, first_len, dest);
+            RelocateElements(data_array, second_len, dest + first_len);
+        }
 
-            b_init = obj_being_copied.b_init;
-            init_val = obj_being_copied.init_val;
-            elms_changed = obj_being_copied.elms_changed;
+        /**
+         * Destroys the element at an index of the #data_array, leaving the slot as raw storage. If the
+         * array is being treated as initialized and the slot was never changed, there is nothing to
+         * destroy.
+         *
+         * @param[in] idx The index of the #data_array to destroy.
+         */
+        void DestroyAt(int idx)
+        {
+            if (b_init)
+            {
+                if (!WasChanged(idx))
+                {
+                    return;
+                }
 
-            ref_val = obj_being_copied.ref_val;
+                tracker.Unmark(idx);
+            }
 
-            // Initialze new arrays to be used for the deep copy
-            elmtype * new_data_array  = new elmtype[arr_capacity];
-            int     * new_idx_array   = new int[arr_capacity];
-            int     * new_point_array = new int[arr_capacity];
+            data_array[idx].~elmtype();
+        }
 
-            // Perform a deep copy of the dyanmically allocated arrays
-            for (int idx = 0; idx < arr_capacity; idx++)
+        /**
+         * Destroys every element of the array and frees all of the arrays.
+         */
+        void FreeArrays()
+        {
+            if (!is_trivially_destructible<elmtype>::value)
             {
-                new_data_array[idx] = obj_being_copied.data_array[idx];
-
-                if (b_init)
+                for (int idx = 0; idx < user_size; idx++)
                 {
-                    new_idx_array[idx]   = obj_being_copied.idx_array[idx];
-                    new_point_array[idx] = obj_being_copied.point_array[idx];
+                    int const idx_to_destroy = WrapIdx(front_idx + idx);
+
+                    if (!b_init || WasChanged(idx_to_destroy))
+                    {
+                        data_array[idx_to_destroy].~elmtype();
+                    }
                 }
             }
 
-            // Set the class array variable to the copied arrays.
-            data_array  = new_data_array;
-            idx_array   = new_idx_array;
-            point_array = new_point_array;
+            Deallocate(data_array);
+            tracker.Free();
 
-            return *this;
+            data_array = NULL;
         }
 
         /**
-         * Copy constructor for the CDA class.
+         * Copies the arrays and attributes of another CDA object. Only the elements in use are
+         * constructed, and they keep the same indexes.
          *
-         * @param[in] obj_being_copied A reference to a CDA object that should be used to create a
-         *                             new CDA object.
+         * @param[in] obj_being_copied The CDA object to copy.
+         *
+         * @note Any prior arrays must already have been freed.
          */
-        CDA(const CDA &obj_being_copied)
+        void CopyArrays(const CDA & obj_being_copied)
         {
             // Update the local class attributes
             user_size    = obj_being_copied.user_size;
@@ -194,385 +344,1478 @@ class CDA
 
             b_init = obj_being_copied.b_init;
             init_val = obj_being_copied.init_val;
-            elms_changed = obj_being_copied.elms_changed;
 
             ref_val = obj_being_copied.ref_val;
 
+            resize_policy     = obj_being_copied.resize_policy;
+            reserved_capacity = obj_being_copied.reserved_capacity;
+
             // Initialze new arrays to be used for the deep copy
-            elmtype * new_data_array  = new elmtype[arr_capacity];
-            int     * new_idx_array   = new int[arr_capacity];
-            int     * new_point_array = new int[arr_capacity];
+            data_array = Allocate(arr_capacity);
 
-            // Perform a deep copy of the dynamically allocated arrays
-            for (int idx = 0; idx < arr_capacity; idx++)
+            if (b_init)
             {
-                new_data_array[idx] = obj_being_copied.data_array[idx];
+                // The slots keep the same indexes, so the tracker can be copied as it is
+                tracker.Copy(obj_being_copied.tracker);
 
-                if (b_init)
+                // Only the elements that have been changed hold a value
+                for (int idx = 0; idx < user_size; idx++)
                 {
-                    new_idx_array[idx]   = obj_being_copied.idx_array[idx];
-                    new_point_array[idx] = obj_being_copied.point_array[idx];
+                    int const idx_to_copy = WrapIdx(front_idx + idx);
+
+                    if (WasChanged(idx_to_copy))
+                    {
+                        ::new (static_cast<void *>(data_array + idx_to_copy)) elmtype(obj_being_copied.data_array[idx_to_copy]);
+                    }
                 }
             }
-
-            // Set the attributes equal to the copy arrays
-            data_array  = new_data_array;
-            idx_array   = new_idx_array;
-            point_array = new_point_array;
+            else
+            {
+                int const first_len  = min(user_size, arr_capacity - front_idx);
+                int const second_len = user_size - first_len;
+
+                uninitialized_copy(obj_being_copied.data_array + front_idx,
+                                   obj_being_copied.data_array + front_idx + first_len,
+                                   data_array + front_idx);
+                uninitialized_copy(obj_being_copied.data_array,
+                                   obj_being_copied.data_array + second_len,
+                                   data_array);
+            }
         }
 
         /**
-         * Destructor for the CDA class.
+         * Moves the elements into new storage of the given capacity, starting at index 0.
          *
-         * @note Deletes any non-NULL array that may have been allocated during runtime.
+         * @param[in] new_arr_capacity The capacity of the new storage, which must be at least
+         *                             #user_size.
+         *
+         * @note If the #data_array was initialized in constant time then the #tracker is rebuilt as
+         *       well, and only the changed elements are moved.
          */
-        ~CDA()
+        void Reallocate(int new_arr_capacity)
         {
-            if (NULL != data_array)
-            {
-                delete[] data_array;
-                data_array = NULL;
-            }
-            if (NULL != idx_array)
+            elmtype * new_data_array = Allocate(new_arr_capacity);
+
+            // Keep track of the values that have been changed and are being moved over.
+            init_tracker new_tracker;
+
+            if (b_init)
             {
-                delete[] idx_array;
-                idx_array = NULL;
+                new_tracker.Create(new_arr_capacity);
+
+                for (int idx = 0; idx < user_size; idx++)
+                {
+                    int const idx_to_copy = WrapIdx(front_idx + idx);
+
+                    // Only the changed values hold anything, the rest are left as raw storage.
+                    if (WasChanged(idx_to_copy))
+                    {
+                        new_tracker.Mark(idx);
+
+                        RelocateElements(data_array + idx_to_copy, 1, new_data_array + idx);
+                    }
+                }
             }
-            if (NULL != point_array)
+            else
             {
-                delete[] point_array;
-                idx_array = NULL;
+                // Nothing to track, so the segments can be moved over directly
+                RelocateSegmentsTo(new_data_array);
             }
+
+            // Free the memory used by the old arrays, the elements have already been moved out
+            Deallocate(data_array);
+            tracker.Free();
+
+            // Store the new array pointers
+            data_array = new_data_array;
+            tracker.Take(new_tracker);
+
+            // Reset front and back indexes, and update the capacity
+            arr_capacity = new_arr_capacity;
+            front_idx    = 0;
+            back_idx     = (user_size == arr_capacity) ? 0 : user_size;
         }
 
         /**
-         * Returns the size of the array.
-         *
-         * @return The size of the array that the user has access to.
+         * Grows a full array by the growth factor of the #resize_policy.
          */
-        int Length()
+        void Grow()
         {
-            return user_size;
+            int const new_arr_capacity = static_cast<int>(arr_capacity * resize_policy.growth_factor);
+
+            // Always grow by at least one element, an empty array grows to a capacity of 1
+            Reallocate(capacity_policy::RoundCapacity(max(new_arr_capacity, user_size + 1)));
         }
 
         /**
-         * Returns the capacity of the array.
-         *
-         * @return The total capicity of the array.
+         * Halves the array as many times as the #resize_policy allows after elements have been
+         * deleted. The elements are only moved once, no matter how many times the array is halved.
          */
-        int Capacity()
+        void CheckShrink()
         {
-            return arr_capacity;
+            int const floor_capacity = max(resize_policy.min_capacity, reserved_capacity);
+
+            int new_arr_capacity = arr_capacity;
+
+            while (resize_policy.b_shrink &&
+                   (user_size <= (new_arr_capacity / resize_policy.shrink_divisor)) &&
+                   ((new_arr_capacity / 2) >= max(floor_capacity, user_size)))
+            {
+                new_arr_capacity /= 2;
+            }
+
+            if (new_arr_capacity != arr_capacity)
+            {
+                Reallocate(new_arr_capacity);
+            }
         }
 
         /**
-         * Overload versin of the [] operator for the CDA class.
+         * Makes sure the array has room for n more elements, growing it at most once.
          *
-         * @param[in] idx The index of the array that the user wants to access.
-         *
-         * @return A reference to a value in the #data_array.
+         * @param[in] n The number of elements about to be added.
          */
-        elmtype &operator[](int idx)
+        void GrowFor(int n)
         {
-            if ((idx > (user_size - 1)) || (idx < 0)) //< If the idx is out of the accesible range.
+            if ((user_size + n) > arr_capacity)
             {
-                cout << "Index out of bounds!\n";
-                return ref_val;
-            }
-            else //< Return a reference to the idx of the array.
-            {
-                int idx_to_access = (front_idx + idx) % arr_capacity;
+                int const grown_capacity = static_cast<int>(arr_capacity * resize_policy.growth_factor);
 
-                bool b_initialized = true;
+                Reallocate(capacity_policy::RoundCapacity(max(grown_capacity, user_size + n)));
+            }
+        }
 
-                if (b_init)
-                {
-                    if (idx_array[idx_to_access] < elms_changed)
-                    {
-                        if ((idx_array[idx_to_access] >= 0) && (idx_array[idx_to_access] < arr_capacity))
-                        {
-                            if (point_array[idx_array[idx_to_access]] == idx_to_access)
-                            {
-                                // Data is valid, return the reference.
-                                b_initialized = false;
-                                return data_array[idx_to_access];
-                            }
-                        }
-                    }
+        /**
+         * Copies elements into raw storage of the #data_array starting at an index, wrapping around
+         * the end of the #data_array. The new elements are registered as changed if the array is
+         * being treated as initialized.
+         *
+         * @param[in] src   The elements to copy.
+         * @param[in] n     The number of elements to copy, which must fit in the unused part of the
+         *                  #data_array.
+         * @param[in] start The index of the #data_array to copy the first element to.
+         */
+        void CopyInto(const elmtype * src, int n, int start)
+        {
+            int const first_len = min(n, arr_capacity - start);
 
-                    if (b_initialized)
-                    {
-                        // Insert the init value into the array and update the arrays.
-                        idx_array[idx_to_access]  = elms_changed;
-                        point_array[elms_changed] = idx_to_access;
-                        data_array[idx_to_access] = init_val;
-                        elms_changed++;
+            uninitialized_copy(src, src + first_len, data_array + start);
+            uninitialized_copy(src + first_len, src + n, data_array);
 
-                        return data_array[idx_to_access];
-                    }
+            if (b_init)
+            {
+                // Unused slots are never registered, so the new ones can be added without checking
+                for (int idx = 0; idx < n; idx++)
+                {
+                    tracker.Mark(WrapIdx(start + idx));
                 }
-
-                // Array was not initialized return the reference.
-                return data_array[idx_to_access];
             }
         }
 
         /**
-         * Functions to double the size of the #data_array.
+         * Destroys n elements of the #data_array starting at an index, wrapping around the end of the
+         * #data_array.
          *
-         * @note If the #data_array was initialized in constant time then the #idx_array and #point_array
-         *       will also be doubled.
+         * @param[in] n     The number of elements to destroy.
+         * @param[in] start The index of the #data_array of the first element to destroy.
          */
-        void DoubleArray()
+        void DestroyRange(int n, int start)
         {
-            // Calculate the size of the new array
-            int new_arr_capacity = (2 * arr_capacity);
-
-            // Create a new array that is twice as big as the current one
-            elmtype * new_data_array = new elmtype[new_arr_capacity];
-            int * new_idx_array      = NULL;
-            int * new_point_array    = NULL;
-
             if (b_init)
             {
-                // Create new arrays for the init functionality
-                new_idx_array   = new int[new_arr_capacity];
-                new_point_array = new int[new_arr_capacity];
+                for (int idx = 0; idx < n; idx++)
+                {
+                    DestroyAt(WrapIdx(start + idx));
+                }
             }
-
-            // Keep track of the values that have been changed and are being copied over.
-            int new_elms_changed = 0;
-
-            // Copy the data over to the new array
-            for (int idx = 0; idx < user_size; idx++)
+            else if (!is_trivially_destructible<elmtype>::value)
             {
-                int const idx_to_copy = (front_idx + idx) % arr_capacity;
+                int const first_len = min(n, arr_capacity - start);
 
-                if (b_init)
+                for (int idx = 0; idx < first_len; idx++)
                 {
-                    // If the value has been changed, use the #new_elms_changed variable to update
-                    // the new arrays.
-                    if (WasChanged(idx_to_copy))
-                    {
-                        new_idx_array[idx] = new_elms_changed;
-                        new_point_array[new_elms_changed] = idx;
-                        new_elms_changed++;
-                    }
+                    data_array[start + idx].~elmtype();
+                }
+                for (int idx = 0; idx < (n - first_len); idx++)
+                {
+                    data_array[idx].~elmtype();
                 }
-
-                // Copy the data value over
-                new_data_array[idx] = data_array[idx_to_copy];
             }
+        }
 
-            // Set the elms_changed variable
-            elms_changed = new_elms_changed;
+        /**
+         * Returns true if a pointer points into the #data_array.
+         */
+        bool InArray(const elmtype * ptr)
+        {
+            less<const elmtype *> before;
 
-            // Free the memory used by the old arrays
-            if (NULL != data_array)
-            {
-                delete[] data_array;
-                data_array = NULL;
-            }
-            if (NULL != idx_array)
-            {
-                delete[] idx_array;
-                idx_array = NULL;
-            }
-            if (NULL != point_array)
+            return !before(ptr, data_array) && before(ptr, data_array + arr_capacity);
+        }
+
+        /**
+         * Marks an index of the #data_array as changed, if the array is being treated as initialized.
+         *
+         * @param[in] idx The index of the #data_array that is being written to.
+         */
+        void MarkChanged(int idx)
+        {
+            if (b_init && !tracker.WasChanged(idx))
             {
-                delete[] point_array;
-                idx_array = NULL;
+                tracker.Mark(idx);
             }
-
-            // Store the new array pointer(s)
-            data_array  = new_data_array;
-            idx_array   = new_idx_array;
-            point_array = new_point_array;
-
-            // Reset front and back indexes
-            front_idx = 0;
-            back_idx  = user_size;
-
-            // Update the capacity variable
-            arr_capacity = new_arr_capacity;
-
         }
 
         /**
-         * Adds an element to the back of the #data_array.
+         * Constructs a new element just past the back of the array.
          *
-         * @param[in] data_val The data element to be added to the end of the array.
+         * @param[in] args The arguments to pass to the elmtype constructor.
          *
-         * @note Will double the size of the array in O(N) time if the array is at maximum capacity.
+         * @note The array must not be full.
          */
-        void AddEnd(elmtype data_val)
+        template <typename... arg_types>
+        void ConstructEnd(arg_types &&... args)
         {
-            // If the array is full, double it
-            if (user_size == arr_capacity)
-            {
-                DoubleArray();
-            }
+            ::new (static_cast<void *>(data_array + back_idx)) elmtype(forward<arg_types>(args)...);
 
-            // Add the element at the front index
-            if (b_init)
-            {
-                data_array[back_idx]      = data_val;
-                idx_array[back_idx]       = elms_changed;
-                point_array[elms_changed] = back_idx;
-                elms_changed++;
-            }
-            else
-            {
-                data_array[back_idx] = data_val;
-            }
+            MarkChanged(back_idx);
 
             // Update the size of the array the user has access to as well as the back_idx.
             user_size++;
-            back_idx = (back_idx + 1) % arr_capacity;
+            back_idx = WrapIdx(back_idx + 1);
         }
 
         /**
-         * Adds an element to the front of the circular dynamic array.
+         * Constructs a new element just before the front of the array.
          *
-         * @param[in] v The data element to be added to the front of the array.
+         * @param[in] args The arguments to pass to the elmtype constructor.
          *
-         * @note Will double the size of the array in O(N) time if the array is at maximum capacity.
+         * @note The array must not be full.
          */
-        void AddFront(elmtype v)
+        template <typename... arg_types>
+        void ConstructFront(arg_types &&... args)
         {
-            // If the array is full, double it
-            if (user_size == arr_capacity)
-            {
-                DoubleArray();
-            }
+            int const idx = WrapIdx(front_idx - 1 + arr_capacity);
 
-            // Update the front_idx variable
-            front_idx = (front_idx - 1 + arr_capacity) % arr_capacity;
+            ::new (static_cast<void *>(data_array + idx)) elmtype(forward<arg_types>(args)...);
 
-            // Add the element at the front index
-            if (b_init)
-            {
-                data_array[front_idx]      = v;
-                idx_array[front_idx]       = elms_changed;
-                point_array[elms_changed]  = front_idx;
-                elms_changed++;
-            }
-            else
-            {
-                data_array[front_idx] = v;
-            }
+            MarkChanged(idx);
 
+            // Update the front_idx variable
+            front_idx = idx;
             user_size++;
         }
 
         /**
-         * Function that checks whether a given index in the data array has been changed or not after
-         * it had been initialzed to a certain value
+         * Constructs a copy of the #init_val in a raw slot of the #data_array.
+         *
+         * @note Only called while the array is treated as initialized, which the init constructor
+         *       only allows for copyable types, so an array of a move-only type never gets here.
+         */
+        void ConstructInitVal(int idx)
+        {
+            ConstructInitVal(idx, is_copy_constructible<elmtype>());
+        }
+
+        /**
+         * Copies the #init_val into a raw slot, for a copyable elmtype.
+         */
+        void ConstructInitVal(int idx, true_type)
+        {
+            ::new (static_cast<void *>(data_array + idx)) elmtype(init_val);
+        }
+
+        /**
+         * Stands in for the copy for a move-only elmtype, which is never treated as initialized.
+         */
+        void ConstructInitVal(int, false_type)
+        {
+            assert(false && "A move-only array can't be treated as initialized");
+        }
+
+        /**
+         * Writes the init value into every element that has not been changed, so that the array
+         * no longer needs to be treated as initialized.
+         *
+         * @note Takes O(N) time, and frees the #tracker.
+         */
+        void InsertInitValues()
+        {
+            if (!b_init)
+            {
+                return;
+            }
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                int const idx_to_set = WrapIdx(front_idx + idx);
+
+                if (!WasChanged(idx_to_set))
+                {
+                    ConstructInitVal(idx_to_set);
+                }
+            }
+
+            // Init values have been stored in the array, so it can now function as an uninitialized
+            // array.
+            b_init = false;
+
+            // Freeing unneeded memory
+            tracker.Free();
+        }
+
+        /**
+         * Moves the elements of the #data_array so that they are one contiguous block starting at
+         * index 0.
+         *
+         * @note Should only be used when the array is not being treated as initialized.
+         */
+        void Linearize()
+        {
+            if (user_size == arr_capacity)
+            {
+                // Every slot holds an element, so they can be rotated in place
+                rotate(data_array, data_array + front_idx, data_array + arr_capacity);
+
+                front_idx = 0;
+                back_idx  = 0;
+            }
+            else
+            {
+                Reallocate(arr_capacity);
+            }
+        }
+
+        /**
+         * Prepares the array for selection by inserting the init values and making sure the elements are
+         * one contiguous block.
+         *
+         * @return A pointer to the first element of the array.
+         */
+        elmtype * SelectSection()
+        {
+            InsertInitValues();
+
+            if ((front_idx + user_size) > arr_capacity)
+            {
+                Linearize();
+            }
+
+            return data_array + front_idx;
+        }
+
+        /**
+         * Sorts an array of an integral or floating point type with the radix sort.
+         */
+        void SortImpl(true_type)
+        {
+            RadixSort();
+        }
+
+        /**
+         * Sorts an array of any other type with the merge sort.
+         */
+        void SortImpl(false_type)
+        {
+            MergeSort(0, user_size - 1);
+        }
+
+        /**
+         * Returns a reference to an element of the array, which must be in bounds. If the array is
+         * being treated as initialized and the element was never changed, the init value is
+         * constructed in its slot first.
+         *
+         * @param[in] idx The index of the array, from the front.
+         *
+         * @return A reference to a value in the #data_array.
+         */
+        elmtype &Access(int idx)
+        {
+            int const idx_to_access = WrapIdx(front_idx + idx);
+
+            if (b_init && !tracker.WasChanged(idx_to_access))
+            {
+                // Construct the init value in the array and record the slot as changed.
+                ConstructInitVal(idx_to_access);
+                tracker.Mark(idx_to_access);
+            }
+
+            return data_array[idx_to_access];
+        }
+
+        /**
+         * Returns a const reference to an element of the array, which must be in bounds, without
+         * changing the array. If the array is being treated as initialized and the element was never
+         * changed, a reference to the #init_val is returned.
+         *
+         * @param[in] idx The index of the array, from the front.
+         *
+         * @return A const reference to the value at idx.
+         */
+        const elmtype &Access(int idx) const
+        {
+            int const idx_to_read = WrapIdx(front_idx + idx);
+
+            if (b_init && !tracker.WasChanged(idx_to_read))
+            {
+                return init_val;
+            }
+
+            return data_array[idx_to_read];
+        }
+
+        /**
+         * Random access iterator over the array. It refers to a position from the front of the array
+         * and goes through the circular wrap, and through the #tracker when the array is treated as
+         * initialized, on every access. It stays valid while elements are added or deleted at the
+         * back, even if the array is resized, but not when the front of the array changes.
+         *
+         * @tparam b_const True for a const_iterator. Reading an element that was never changed then
+         *                 returns the #init_val instead of constructing it in the array.
+         */
+        template <bool b_const>
+        class IteratorImpl
+        {
+            friend class CDA;
+            friend class IteratorImpl<!b_const>;
+
+            typedef typename conditional<b_const, const CDA, CDA>::type cda_type;
+
+            cda_type * arr; ///< The array being iterated over.
+            int        pos; ///< The index of the array, from the front, that the iterator is at.
+
+            public:
+
+                typedef random_access_iterator_tag iterator_category;
+                typedef elmtype                    value_type;
+                typedef ptrdiff_t                  difference_type;
+
+                typedef typename conditional<b_const, const elmtype *, elmtype *>::type pointer;
+                typedef typename conditional<b_const, const elmtype &, elmtype &>::type reference;
+
+                IteratorImpl() : arr(NULL), pos(0)
+                {
+                }
+
+                IteratorImpl(cda_type * arr_ptr, int idx) : arr(arr_ptr), pos(idx)
+                {
+                }
+
+                /**
+                 * Converts an iterator to a const_iterator.
+                 */
+                template <bool b_other, typename = typename enable_if<b_const && !b_other>::type>
+                IteratorImpl(const IteratorImpl<b_other> & other) : arr(other.arr), pos(other.pos)
+                {
+                }
+
+                /**
+                 * Returns the index of the array, from the front, that the iterator is at.
+                 */
+                int Index() const
+                {
+                    return pos;
+                }
+
+                reference operator*() const
+                {
+                    return arr->Access(pos);
+                }
+
+                pointer operator->() const
+                {
+                    return &arr->Access(pos);
+                }
+
+                reference operator[](difference_type n) const
+                {
+                    return arr->Access(pos + static_cast<int>(n));
+                }
+
+                IteratorImpl & operator++()
+                {
+                    pos++;
+                    return *this;
+                }
+
+                IteratorImpl operator++(int)
+                {
+                    IteratorImpl const old = *this;
+                    pos++;
+                    return old;
+                }
+
+                IteratorImpl & operator--()
+                {
+                    pos--;
+                    return *this;
+                }
+
+                IteratorImpl operator--(int)
+                {
+                    IteratorImpl const old = *this;
+                    pos--;
+                    return old;
+                }
+
+                IteratorImpl & operator+=(difference_type n)
+                {
+                    pos += static_cast<int>(n);
+                    return *this;
+                }
+
+                IteratorImpl & operator-=(difference_type n)
+                {
+                    pos -= static_cast<int>(n);
+                    return *this;
+                }
+
+                IteratorImpl operator+(difference_type n) const
+                {
+                    return IteratorImpl(arr, pos + static_cast<int>(n));
+                }
+
+                IteratorImpl operator-(difference_type n) const
+                {
+                    return IteratorImpl(arr, pos - static_cast<int>(n));
+                }
+
+                friend IteratorImpl operator+(difference_type n, const IteratorImpl & it)
+                {
+                    return it + n;
+                }
+
+                template <bool b_other>
+                difference_type operator-(const IteratorImpl<b_other> & other) const
+                {
+                    return pos - other.pos;
+                }
+
+                template <bool b_other>
+                bool operator==(const IteratorImpl<b_other> & other) const
+                {
+                    return pos == other.pos;
+                }
+
+                template <bool b_other>
+                bool operator!=(const IteratorImpl<b_other> & other) const
+                {
+                    return pos != other.pos;
+                }
+
+                template <bool b_other>
+                bool operator<(const IteratorImpl<b_other> & other) const
+                {
+                    return pos < other.pos;
+                }
+
+                template <bool b_other>
+                bool operator>(const IteratorImpl<b_other> & other) const
+                {
+                    return pos > other.pos;
+                }
+
+                template <bool b_other>
+                bool operator<=(const IteratorImpl<b_other> & other) const
+                {
+                    return pos <= other.pos;
+                }
+
+                template <bool b_other>
+                bool operator>=(const IteratorImpl<b_other> & other) const
+                {
+                    return pos >= other.pos;
+                }
+        };
+
+        /**
+         * Finds a bound in a sorted array with the branchless binary search.
+         *
+         * @tparam b_upper True to find the upper bound, false to find the lower bound.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The index of the bound.
+         */
+        template <bool b_upper>
+        int Bound(const elmtype & e)
+        {
+            if (b_init)
+            {
+                // Unchanged elements are read as the init value without being constructed
+                const CDA * self = this;
+
+                return BranchlessBound<b_upper>([self](int idx) -> const elmtype & { return self->Access(idx); },
+                                                user_size, e);
+            }
+
+            int const first_len  = min(user_size, arr_capacity - front_idx);
+            int const second_len = user_size - first_len;
+
+            const elmtype * first  = data_array + front_idx;
+            const elmtype * second = data_array;
+
+            // The bound is in the second segment only if its first element comes before it
+            if ((second_len > 0) && BeforeBound<b_upper>(second[0], e))
+            {
+                int const idx = BranchlessBound<b_upper>([second](int idx) -> const elmtype & { return second[idx]; },
+                                                         second_len, e);
+
+                return first_len + idx;
+            }
+
+            return BranchlessBound<b_upper>([first](int idx) -> const elmtype & { return first[idx]; },
+                                            first_len, e);
+        }
+
+        /**
+         * Finds the lower bound of each key of a batch, advancing a group of searches one level at a
+         * time. The next probe of each search is prefetched as soon as it is known, so the cache
+         * misses of the whole group overlap instead of each search waiting on its own chain of misses.
+         *
+         * @param[in]  keys The keys to search for.
+         * @param[in]  n    The number of keys.
+         * @param[out] out  Set to the lower bound of each key.
+         *
+         * @note Should only be used when the array is not being treated as initialized.
+         */
+        void GroupLowerBound(const elmtype * keys, int n, int * out)
+        {
+            int const first_len  = min(user_size, arr_capacity - front_idx);
+            int const second_len = user_size - first_len;
+
+            const elmtype * first  = data_array + front_idx;
+            const elmtype * second = data_array;
+
+            const elmtype * base[batch_group];  //< The start of the range each search has left.
+            int             len[batch_group];   //< The length of the range each search has left.
+            int             start[batch_group]; //< The index of the array of each search's segment.
+            const elmtype * seg[batch_group];   //< The segment each search runs in.
+
+            for (int group = 0; group < n; group += batch_group)
+            {
+                int const       count      = ((n - group) < batch_group) ? (n - group) : batch_group;
+                const elmtype * group_keys = keys + group;
+
+                // Start each search in the segment its bound is in, and prefetch its first probe
+                for (int idx = 0; idx < count; idx++)
+                {
+                    bool const b_second = (second_len > 0) && (second[0] < group_keys[idx]);
+
+                    seg[idx]   = b_second ? second : first;
+                    base[idx]  = seg[idx];
+                    len[idx]   = b_second ? second_len : first_len;
+                    start[idx] = b_second ? first_len : 0;
+
+                    __builtin_prefetch(base[idx] + (len[idx] / 2) - (len[idx] > 1));
+                }
+
+                // The length of a range doesn't depend on the comparisons, so every search in the
+                // same segment finishes on the same pass.
+                bool b_active = true;
+
+                while (b_active)
+                {
+                    b_active = false;
+
+                    for (int idx = 0; idx < count; idx++)
+                    {
+                        if (len[idx] > 1)
+                        {
+                            int const half = len[idx] / 2;
+
+                            base[idx] += (base[idx][half - 1] < group_keys[idx]) ? half : 0;
+                            len[idx]  -= half;
+
+                            __builtin_prefetch(base[idx] + (len[idx] / 2) - (len[idx] > 1));
+
+                            b_active = true;
+                        }
+                    }
+                }
+
+                for (int idx = 0; idx < count; idx++)
+                {
+                    int const bound = static_cast<int>(base[idx] - seg[idx]) +
+                                      (((len[idx] > 0) && (base[idx][0] < group_keys[idx])) ? 1 : 0);
+
+                    out[group + idx] = start[idx] + bound;
+                }
+            }
+        }
+
+        /**
+         * Finds the lower bound of each key of a sorted batch with a merge style sweep. Each search
+         * gallops forward from the bound of the previous key, so the whole batch reads the array once
+         * in order and takes O(n log(N / n)) comparisons.
+         *
+         * @param[in]  keys The keys to search for, in sorted order.
+         * @param[in]  n    The number of keys.
+         * @param[out] out  Set to the lower bound of each key.
+         */
+        void SweepLowerBound(const elmtype * keys, int n, int * out)
+        {
+            const CDA & self = *this;
+            int         lo   = 0; //< Every element before lo is less than the current key.
+
+            for (int idx = 0; idx < n; idx++)
+            {
+                // Gallop forward until an element that is not less than the key is passed
+                int step = 1;
+
+                while (((lo + step) <= user_size) && (self.Access(lo + step - 1) < keys[idx]))
+                {
+                    lo   += step;
+                    step *= 2;
+                }
+
+                int const hi = min(lo + step - 1, user_size);
+
+                lo += BranchlessBound<false>([&self, lo](int pos) -> const elmtype & { return self.Access(lo + pos); },
+                                             hi - lo, keys[idx]);
+
+                out[idx] = lo;
+            }
+        }
+
+        /**
+         * Moves the elements at indexes [from, to) of the array up by one index, starting at the top.
+         * The element at index to must already be constructed, and the one at from is left moved from.
+         *
+         * @note Should only be used when the array is not being treated as initialized.
+         */
+        void ShiftUp(int from, int to)
+        {
+            int dst = WrapIdx(front_idx + to);
+
+            for (int count = to - from; count > 0; count--)
+            {
+                int const src = (dst == 0) ? (arr_capacity - 1) : (dst - 1);
+
+                data_array[dst] = move(data_array[src]);
+                dst = src;
+            }
+        }
+
+        /**
+         * Moves the elements at indexes (from, to] of the array down by one index, starting at the
+         * bottom. The element at index to is left moved from.
+         *
+         * @note Should only be used when the array is not being treated as initialized.
+         */
+        void ShiftDown(int from, int to)
+        {
+            int dst = WrapIdx(front_idx + from);
+
+            for (int count = to - from; count > 0; count--)
+            {
+                int const src = ((dst + 1) == arr_capacity) ? 0 : (dst + 1);
+
+                data_array[dst] = move(data_array[src]);
+                dst = src;
+            }
+        }
+
+        /**
+         * Merges sorted arrays into a new array with the given number of threads.
+         */
+        static CDA MergeSortedImpl(CDA ** inputs, int k, int threads)
+        {
+            typedef typename LoserTreeMerger<elmtype>::Run Run;
+
+            Run * runs  = new Run[max(1, k)];
+            int   total = 0;
+
+            for (int idx = 0; idx < k; idx++)
+            {
+                elmtype * first;
+                elmtype * second;
+
+                inputs[idx]->Segments(first, runs[idx].first_len, second, runs[idx].second_len);
+
+                runs[idx].first  = first;
+                runs[idx].second = second;
+
+                total += inputs[idx]->user_size;
+            }
+
+            // Allocate the merged array at its final size, then construct the elements straight into it
+            CDA merged(0);
+
+            merged.Reallocate(capacity_policy::RoundCapacity(max(1, total)));
+
+            if (threads > 1)
+            {
+                ThreadPool pool(threads);
+
+                LoserTreeMerger<elmtype>::ParallelMerge(runs, k, merged.data_array, pool);
+            }
+            else
+            {
+                LoserTreeMerger<elmtype>::Merge(runs, k, merged.data_array);
+            }
+
+            merged.user_size = total;
+            merged.back_idx  = (total == merged.arr_capacity) ? 0 : total;
+
+            delete[] runs;
+
+            return merged;
+        }
+
+    public:
+
+        typedef IteratorImpl<false> iterator;       ///< Iterator that can change the elements.
+        typedef IteratorImpl<true>  const_iterator; ///< Iterator that only reads the elements.
+
+        typedef std::reverse_iterator<iterator>       reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        /**
+         * The default constructor, sets the arr_capacity to 1, and user_size to 0.
+         *
+         * Runs in O(1) time
+         */
+        CDA(void)
+        {
+            // The array has a capacity of 1, but the user has not added any elements.
+            user_size    = 0;
+            arr_capacity = 1;
+
+            // The array has not been initialized
+            b_init = false;
+
+            // No elements have been added so the front and back are both at idx 0.
+            front_idx = 0;
+            back_idx  = 0;
+
+            // Allocates storage for 1 element.
+            data_array = Allocate(1);
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s and #arr_capacity s.
          *
-         * @param[in] idx The index to be checked.
+         * @param[in] s The value used to initialize user_size and arr_capacity.
          *
-         * @retval true  The index has been changed.
-         * @retval false The index has not been changed.
+         * @note When using the #PowerOfTwoCapacity policy, #arr_capacity is rounded up to the next
+         *       power of two.
+         */
+        CDA(int s)
+        {
+            // The user_size and arr_capcity variable should match, unless the policy rounds it up.
+            user_size    = s;
+            arr_capacity = capacity_policy::RoundCapacity(s);
+
+            // The array has not been initialized.
+            b_init = false;
+
+            // The back index is 0 if the array is full, otherwise it is just past the last element.
+            front_idx = 0;
+            back_idx  = (user_size == arr_capacity) ? 0 : user_size;
+
+            // Allocates storage of size arr_capacity, and constructs the first user_size elements.
+            data_array = Allocate(arr_capacity);
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                ::new (static_cast<void *>(data_array + idx)) elmtype;
+            }
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s and #arr_capacity s. The array created
+         * should act as though it has been initialized with the value init, but it should still be
+         * in O(1) time.
+         *
+         * @param[in] s    The value used to initialize the #user_size and #arr_capacity.
+         * @param[in] init The value that the array should act as though it has been initialized with.
+         *
+         * @note When using the #PowerOfTwoCapacity policy, #arr_capacity is rounded up to the next
+         *       power of two.
+         *
+         * @note The changed slots are recorded by the #init_tracker, see InitTracker.cpp for the
+         *       layouts that can be chosen.
+         */
+        CDA(int s, elmtype init)
+        {
+            // Variables specific to the initialized array
+            b_init             = true;
+            init_val           = init;
+
+            // User size and capacity should both be equal to the size of the array, unless the policy
+            // rounds the capacity up.
+            user_size    = s;
+            arr_capacity = capacity_policy::RoundCapacity(s);
+
+            // The back index is 0 if the array is full, otherwise it is just past the last element.
+            front_idx = 0;
+            back_idx  = (user_size == arr_capacity) ? 0 : user_size;
+
+            // The data array as well as the tracker needed to initialize an array in constant time.
+            // Both should be of size arr_capacity. No elements are constructed until they are changed.
+            data_array = Allocate(arr_capacity);
+            tracker.Create(arr_capacity);
+        }
+
+        /**
+         * Copy Assignment operator.
+         *
+         * @param[in] obj_being_copied A reference to a CDA object that is going to be copied over.
+         *
+         *@return A reference to an updated CDA object that matches #obj_being_copied.
+         */
+        CDA& operator=(const CDA &obj_being_copied)
+        {
+            if (this != &obj_being_copied)
+            {
+                // Must delete any prior data before copying new data over.
+                FreeArrays();
+
+                CopyArrays(obj_being_copied);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Copy constructor for the CDA class.
+         *
+         * @param[in] obj_being_copied A reference to a CDA object that should be used to create a
+         *                             new CDA object.
+         */
+        CDA(const CDA &obj_being_copied)
+        {
+            CopyArrays(obj_being_copied);
+        }
+
+        /**
+         * Move constructor for the CDA class. Takes the arrays of the other object instead of copying
+         * them.
+         *
+         * @param[in] obj_being_moved A CDA object whose arrays should be used to create a new CDA
+         *                            object. It is left empty, with a capacity of 0.
+         */
+        CDA(CDA && obj_being_moved) noexcept
+        {
+            TakeArrays(obj_being_moved);
+        }
+
+        /**
+         * Move Assignment operator.
+         *
+         * @param[in] obj_being_moved A CDA object whose arrays should be moved over. It is left empty,
+         *                            with a capacity of 0.
+         *
+         * @return A reference to an updated CDA object that matches what #obj_being_moved was.
+         */
+        CDA& operator=(CDA && obj_being_moved) noexcept
+        {
+            if (this != &obj_being_moved)
+            {
+                // Must delete any prior data before taking the new data.
+                FreeArrays();
+
+                TakeArrays(obj_being_moved);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Destructor for the CDA class.
+         *
+         * @note Destroys the elements, and deletes any non-NULL array that may have been allocated
+         *       during runtime.
+         */
+        ~CDA()
+        {
+            FreeArrays();
+        }
+
+        /**
+         * Returns the size of the array.
+         *
+         * @return The size of the array that the user has access to.
+         */
+        int Length()
+        {
+            return user_size;
+        }
+
+        /**
+         * Returns the capacity of the array.
+         *
+         * @return The total capicity of the array.
+         */
+        int Capacity()
+        {
+            return arr_capacity;
+        }
+
+        /**
+         * Returns the settings that control when the array grows and shrinks.
+         *
+         * @return The current #resize_policy.
+         */
+        ResizePolicy GetResizePolicy()
+        {
+            return resize_policy;
+        }
+
+        /**
+         * Changes when the array grows and shrinks. Takes effect on the next add or delete.
+         *
+         * @param[in] policy The new settings. A growth factor of 1 or less still grows the array by one
+         *                   element, and a shrink divisor below 2 is treated as 2.
+         */
+        void SetResizePolicy(const ResizePolicy & policy)
+        {
+            resize_policy = policy;
+            resize_policy.shrink_divisor = max(2, resize_policy.shrink_divisor);
+        }
+
+        /**
+         * Makes sure the array has room for at least n elements, so that adding up to n elements
+         * doesn't resize it. Deleting elements won't shrink the array below this capacity until
+         * #ShrinkToFit() is called.
+         *
+         * @param[in] n The number of elements to make room for.
+         *
+         * @note Takes O(N) time if the array has to grow.
+         */
+        void Reserve(int n)
+        {
+            reserved_capacity = max(reserved_capacity, n);
+
+            if (n > arr_capacity)
+            {
+                Reallocate(capacity_policy::RoundCapacity(n));
+            }
+        }
+
+        /**
+         * Shrinks the capacity of the array to fit its elements, and clears the capacity asked for by
+         * #Reserve().
+         *
+         * @note Takes O(N) time. An empty array is left with a capacity of 1.
+         */
+        void ShrinkToFit()
+        {
+            int const new_arr_capacity = capacity_policy::RoundCapacity(max(1, user_size));
+
+            reserved_capacity = 0;
+
+            if (new_arr_capacity != arr_capacity)
+            {
+                Reallocate(new_arr_capacity);
+            }
+        }
+
+        /**
+         * Gets the contents of the array as at most two contiguous segments of the #data_array. The
+         * first segment starts at #front_idx, and the second segment holds the elements that wrapped
+         * around to the start of the #data_array.
+         *
+         * @param[out] first      Set to the start of the first segment.
+         * @param[out] first_len  Set to the number of elements in the first segment.
+         * @param[out] second     Set to the start of the second segment.
+         * @param[out] second_len Set to the number of elements in the second segment.
+         *
+         * @return The number of segments that contain elements.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time.
+         */
+        int Segments(elmtype *& first, int & first_len, elmtype *& second, int & second_len)
+        {
+            InsertInitValues();
+
+            first_len  = min(user_size, arr_capacity - front_idx);
+            second_len = user_size - first_len;
+
+            first  = data_array + front_idx;
+            second = data_array;
+
+            return (first_len > 0) + (second_len > 0);
+        }
+
+        /**
+         * Calls the visitor once for each contiguous segment of the array, in order.
+         *
+         * @param[in] visit A function or functor called as visit(seg, seg_len, start), where seg
+         *                  points to seg_len elements, and start is the index of seg[0] in the array.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time.
+         */
+        template <typename visitor>
+        void ForEachSegment(visitor visit)
+        {
+            elmtype * first;
+            elmtype * second;
+            int first_len;
+            int second_len;
+
+            Segments(first, first_len, second, second_len);
+
+            if (first_len > 0)
+            {
+                visit(first, first_len, 0);
+            }
+            if (second_len > 0)
+            {
+                visit(second, second_len, first_len);
+            }
+        }
+
+        /**
+         * Calls the visitor once for each element of the array, in order. Each segment is walked with a
+         * plain loop, so there is no wrap-around check per element.
+         *
+         * @param[in] visit A function or functor called as visit(elm) with a reference to each element.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time.
+         */
+        template <typename visitor>
+        void ForEach(visitor visit)
+        {
+            elmtype * first;
+            elmtype * second;
+            int first_len;
+            int second_len;
+
+            Segments(first, first_len, second, second_len);
+
+            for (int idx = 0; idx < first_len; idx++)
+            {
+                visit(first[idx]);
+            }
+            for (int idx = 0; idx < second_len; idx++)
+            {
+                visit(second[idx]);
+            }
+        }
+
+        /**
+         * Overload versin of the [] operator for the CDA class. Out of bounds indexes are handled by
+         * the #error_policy.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to a value in the #data_array, or to #ref_val if the #error_policy
+         *         rejects the index.
+         */
+        elmtype &operator[](int idx)
+        {
+            if (!error_policy::InBounds(idx, user_size)) //< If the idx is out of the accesible range.
+            {
+                return ref_val;
+            }
+
+            return Access(idx);
+        }
+
+        /**
+         * Checked accessor that always checks the index, whatever the #error_policy is.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to a value in the #data_array.
+         *
+         * @throws out_of_range The index is out of bounds.
+         */
+        elmtype &At(int idx)
+        {
+            ThrowOnError::InBounds(idx, user_size);
+
+            return Access(idx);
+        }
+
+        /**
+         * Read only accessor, which never changes the array. An element that was never changed after
+         * the array was initialized in constant time is read from the #init_val rather than being
+         * constructed in its slot, so several threads can read the same array at once.
+         *
+         * @param[in] idx The index of the array that the user wants to read.
+         *
+         * @return A const reference to the value at idx, or to #ref_val if the #error_policy rejects
+         *         the index.
+         */
+        const elmtype &Read(int idx)
+        {
+            if (!error_policy::InBounds(idx, user_size))
+            {
+                return ref_val;
+            }
+
+            return static_cast<const CDA &>(*this).Access(idx);
+        }
+
+        /**
+         * Returns an iterator to the front element of the array.
+         */
+        iterator begin()
+        {
+            return iterator(this, 0);
+        }
+
+        /**
+         * Returns an iterator just past the back element of the array.
+         */
+        iterator end()
+        {
+            return iterator(this, user_size);
+        }
+
+        /**
+         * Returns a const_iterator to the front element of the array.
+         */
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        /**
+         * Returns a const_iterator just past the back element of the array.
+         */
+        const_iterator end() const
+        {
+            return const_iterator(this, user_size);
+        }
+
+        /**
+         * Returns a const_iterator to the front element of the array, which never changes the array,
+         * even if it is being treated as initialized.
+         */
+        const_iterator cbegin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        /**
+         * Returns a const_iterator just past the back element of the array.
+         */
+        const_iterator cend() const
+        {
+            return const_iterator(this, user_size);
+        }
+
+        /**
+         * Returns a reverse_iterator to the back element of the array.
          */
-        bool WasChanged(int idx)
+        reverse_iterator rbegin()
         {
-            if (idx_array[idx] < elms_changed)
-            {
-                if ((idx_array[idx] >= 0) && (idx_array[idx] < arr_capacity))
-                {
-                    if (point_array[idx_array[idx]] == idx)
-                    {
-                        return true;
-                    }
-                }
-            }
+            return reverse_iterator(end());
+        }
 
-            return false;
+        /**
+         * Returns a reverse_iterator just before the front element of the array.
+         */
+        reverse_iterator rend()
+        {
+            return reverse_iterator(begin());
         }
 
         /**
-         * Function that halves the size of the data array.
+         * Returns a const_reverse_iterator to the back element of the array.
+         */
+        const_reverse_iterator crbegin() const
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        /**
+         * Returns a const_reverse_iterator just before the front element of the array.
+         */
+        const_reverse_iterator crend() const
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        /**
+         * Segmented iterator hook. Calls the visitor once for each contiguous piece of the range
+         * [first, last), in order, so that an algorithm can run on plain pointers instead of going
+         * through the circular wrap for every element.
          *
-         * @note Takes O(N) time to copy the data to the new array.
+         * @param[in] first The start of the range.
+         * @param[in] last  The end of the range.
+         * @param[in] visit A function or functor called as visit(seg, seg_len, start), where seg
+         *                  points to seg_len elements, and start is the index of seg[0] in the array.
          *
-         * @note If the #data_array was initialized in constant time then the #idx_array and #point_array
-         *       will also be doubled.
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time.
          */
-        void HalfArray()
+        template <typename visitor>
+        void ForEachSegment(iterator first, iterator last, visitor visit)
         {
-            // Compute the new array size
-            int new_arr_capacity = (arr_capacity / 2);
+            elmtype * first_seg;
+            elmtype * second_seg;
+            int first_len;
+            int second_len;
 
-            // Create new arrays that is half the size of the current one
-            elmtype * new_data_array = new elmtype[new_arr_capacity];
-            int * new_idx_array   = NULL;
-            int * new_point_array = NULL;
+            Segments(first_seg, first_len, second_seg, second_len);
 
-            if (b_init)
+            // The part of the range in the first segment
+            int const first_end = min(last.pos, first_len);
+
+            if (first.pos < first_end)
             {
-                // Create new arrays for the init functionality
-                new_idx_array   = new int[new_arr_capacity];
-                new_point_array = new int[new_arr_capacity];
+                visit(first_seg + first.pos, first_end - first.pos, first.pos);
             }
 
-            // Keep track of the values that have been changed and are being copied over.
-            int new_elms_changed = 0;
+            // The part of the range that wrapped around to the second segment
+            int const second_start = max(first.pos, first_len);
 
-            // Copy the data over to the new array
-            for (int idx = 0; idx < user_size; idx++)
+            if (second_start < last.pos)
             {
-                int const idx_to_copy = (front_idx + idx) % arr_capacity;
+                visit(second_seg + (second_start - first_len), last.pos - second_start, second_start);
+            }
+        }
 
-                if (b_init)
-                {
-                    if (WasChanged(idx_to_copy))
-                    {
-                        new_idx_array[idx] = new_elms_changed;
-                        new_point_array[new_elms_changed] = idx;
-                        new_elms_changed++;
-                    }
-                }
+        /**
+         * Functions to double the size of the #data_array.
+         *
+         * @note If the #data_array was initialized in constant time then the #tracker is
+         *       rebuilt as well.
+         */
+        void DoubleArray()
+        {
+            // An empty array grows to a capacity of 1
+            Reallocate(max(1, 2 * arr_capacity));
+        }
 
-                new_data_array[idx] = data_array[idx_to_copy];
-            }
+        /**
+         * Adds an element to the back of the #data_array.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        void AddEnd(const elmtype & data_val)
+        {
+            EmplaceEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the #data_array.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        void AddEnd(elmtype && data_val)
+        {
+            EmplaceEnd(move(data_val));
+        }
 
-            // Set the elms_changed variable
-            elms_changed = new_elms_changed;
+        /**
+         * Constructs an element from the given arguments in place at the back of the #data_array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        template <typename... arg_types>
+        void EmplaceEnd(arg_types &&... args)
+        {
+            if (user_size == arr_capacity)
+            {
+                // The arguments could refer to elements of this array, so build the element before the
+                // array is resized
+                elmtype val(forward<arg_types>(args)...);
 
-            // Free the memory used by the old arrays
-            if (NULL != data_array)
+                Grow();
+                ConstructEnd(move(val));
+            }
+            else
             {
-                delete[] data_array;
-                data_array = NULL;
+                ConstructEnd(forward<arg_types>(args)...);
             }
-            if (NULL != idx_array)
+        }
+
+        /**
+         * Adds an element to the front of the circular dynamic array.
+         *
+         * @param[in] v The data element to be added to the front of the array.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        void AddFront(const elmtype & v)
+        {
+            EmplaceFront(v);
+        }
+
+        /**
+         * Moves an element to the front of the circular dynamic array.
+         *
+         * @param[in] v The data element to be moved to the front of the array.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        void AddFront(elmtype && v)
+        {
+            EmplaceFront(move(v));
+        }
+
+        /**
+         * Constructs an element from the given arguments in place at the front of the circular dynamic
+         * array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         *
+         * @note Will grow the array in O(N) time if the array is at maximum capacity, doubling it by default.
+         */
+        template <typename... arg_types>
+        void EmplaceFront(arg_types &&... args)
+        {
+            if (user_size == arr_capacity)
             {
-                delete[] idx_array;
-                idx_array = NULL;
+                // The arguments could refer to elements of this array, so build the element before the
+                // array is resized
+                elmtype val(forward<arg_types>(args)...);
+
+                Grow();
+                ConstructFront(move(val));
             }
-            if (NULL != point_array)
+            else
             {
-                delete[] point_array;
-                point_array = NULL;
+                ConstructFront(forward<arg_types>(args)...);
             }
+        }
 
-            // Store the new array pointer
-            data_array  = new_data_array;
-            idx_array   = new_idx_array;
-            point_array = new_point_array;
-
-            // Reset the front and back indexes
-            front_idx = 0;
-            back_idx  = user_size;
+        /**
+         * Function that checks whether a given index in the data array has been changed or not after
+         * it had been initialzed to a certain value
+         *
+         * @param[in] idx The index to be checked.
+         *
+         * @retval true  The index has been changed.
+         * @retval false The index has not been changed.
+         */
+        bool WasChanged(int idx)
+        {
+            return tracker.WasChanged(idx);
+        }
 
-            // Update the capacity variable
-            arr_capacity = new_arr_capacity;
+        /**
+         * Function that halves the size of the data array.
+         *
+         * @note Takes O(N) time to copy the data to the new array.
+         *
+         * @note If the #data_array was initialized in constant time then the #tracker is
+         *       rebuilt as well.
+         */
+        void HalfArray()
+        {
+            Reallocate(arr_capacity / 2);
         }
 
         /**
          * Deletes the back element of the array.
          *
-         * @note If the array is only 25% full after the delete, the array will be halved.
+         * @note By default, if the array is only 25% full after the delete, the array will be halved.
          */
         void DelEnd()
         {
@@ -589,22 +1832,19 @@ class CDA
             }
             else
             {
-                back_idx = (back_idx - 1) % arr_capacity;
+                back_idx = WrapIdx(back_idx - 1);
             }
 
+            DestroyAt(back_idx);
             user_size--;
 
-            // Don't let arr_capacity go below 4
-            if ((user_size == (arr_capacity / 4)) && ((arr_capacity / 2) >= 4))
-            {
-                HalfArray();
-            }
+            CheckShrink();
         }
 
         /**
          * Function to delete the front index of the data array
          *
-         * @note Will half the size of the array when 25% of #arr_capacity is being used.
+         * @note By default, will half the size of the array when 25% of #arr_capacity is being used.
          */
         void DelFront()
         {
@@ -615,80 +1855,313 @@ class CDA
             }
 
             // Update the circular array variables
-            front_idx = (front_idx + 1) % arr_capacity;
+            DestroyAt(front_idx);
+            front_idx = WrapIdx(front_idx + 1);
             user_size--;
 
-            // Don't let arr_capacity go below 4
-            if ((user_size == (arr_capacity / 4)) && ((arr_capacity / 2) >= 4))
+            CheckShrink();
+        }
+
+        /**
+         * Adds a range of elements to the back of the array, in order.
+         *
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
+         *
+         * @note The array is resized at most once, and the elements are copied in at most two blocks.
+         */
+        void AppendRange(const elmtype * src, int n)
+        {
+            if (n <= 0)
+            {
+                return;
+            }
+
+            // The elements could come from this array, so copy them before the array is resized
+            if (((user_size + n) > arr_capacity) && InArray(src))
             {
-                HalfArray();
+                CDA tmp(0);
+
+                tmp.AppendRange(src, n);
+                AppendRange(tmp.data_array, n);
+
+                return;
             }
+
+            GrowFor(n);
+            CopyInto(src, n, back_idx);
+
+            user_size += n;
+            back_idx   = WrapIdx(back_idx + n);
         }
 
         /**
-         * The implementation of the binary search algorithm.
+         * Adds a range of elements to the front of the array. Afterwards, src[0] is the front element
+         * and the elements that were already in the array follow src[n - 1].
          *
-         * @param[in]  lower_bound The index of the lowest position of the section being searched.
-         * @param[in]  upper_bound The index of the highest position of the section being searched.
-         * @param[out] e           The element that is being searched for.
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
          *
-         * @return The index of the item if found, otherwise a negative number that is the bitwise
-         *         complement of the index of the next element that is larger than e or, if there is
-         *         no larger element, the bitwise complement of size.
+         * @note The array is resized at most once, and the elements are copied in at most two blocks.
          */
-        int BinSearchImpl(int lower_bound, int upper_bound, elmtype e)
+        void PrependRange(const elmtype * src, int n)
         {
-            int const mid     = (lower_bound + upper_bound) / 2;  //< The middle of the current section.
-            int const mid_idx = (front_idx + mid) % arr_capacity; //< The index of the middle.
+            if (n <= 0)
+            {
+                return;
+            }
 
-            // Recursively search until the the two bounds reach each other
-            if (lower_bound <= upper_bound)
+            // The elements could come from this array, so copy them before the array is resized
+            if (((user_size + n) > arr_capacity) && InArray(src))
             {
-                elmtype data_val;
+                CDA tmp(0);
 
-                if (b_init) //< Check which value to used of the init array
-                {
-                    if (WasChanged(mid_idx))
-                    {
-                        data_val = data_array[mid_idx];
-                    }
-                    else
-                    {
-                        data_val = init_val;
-                    }
-                }
-                else //< Directly access the data variable
-                {
-                    data_val = data_array[mid_idx];
-                }
+                tmp.AppendRange(src, n);
+                PrependRange(tmp.data_array, n);
 
-                if (e == data_val)
-                {
-                    // The element was found
-                    return mid;
-                }
-                else if (e < data_val)
+                return;
+            }
+
+            GrowFor(n);
+
+            int const new_front_idx = WrapIdx(front_idx - n + arr_capacity);
+
+            CopyInto(src, n, new_front_idx);
+
+            user_size += n;
+            front_idx  = new_front_idx;
+        }
+
+        /**
+         * Deletes the first n elements of the array. If n is larger than the size of the array, every
+         * element is deleted.
+         *
+         * @param[in] n The number of elements to delete.
+         *
+         * @note The array is resized at most once.
+         */
+        void DropFront(int n)
+        {
+            n = min(n, user_size);
+
+            if (n <= 0)
+            {
+                return;
+            }
+
+            DestroyRange(n, front_idx);
+
+            front_idx  = WrapIdx(front_idx + n);
+            user_size -= n;
+
+            CheckShrink();
+        }
+
+        /**
+         * Deletes the last n elements of the array. If n is larger than the size of the array, every
+         * element is deleted.
+         *
+         * @param[in] n The number of elements to delete.
+         *
+         * @note The array is resized at most once.
+         */
+        void DropBack(int n)
+        {
+            n = min(n, user_size);
+
+            if (n <= 0)
+            {
+                return;
+            }
+
+            int const new_back_idx = WrapIdx(back_idx - n + arr_capacity);
+
+            DestroyRange(n, new_back_idx);
+
+            back_idx   = new_back_idx;
+            user_size -= n;
+
+            CheckShrink();
+        }
+
+        /**
+         * Performs a binary search on a sorted array for each key of a batch. Unless the array was
+         * initialized in constant time, the searches are run in groups that advance in lockstep with
+         * software prefetching, which hides most of the memory latency of a large array. If the keys
+         * are in sorted order, a merge style sweep is used instead.
+         *
+         * @param[in]  keys The keys to search for.
+         * @param[in]  n    The number of keys.
+         * @param[out] out  Set to what #BinSearch() returns for each key.
+         */
+        void BinSearchBatch(const elmtype * keys, int n, int * out)
+        {
+            if (n <= 0)
+            {
+                return;
+            }
+
+            if (is_sorted(keys, keys + n))
+            {
+                SweepLowerBound(keys, n, out);
+            }
+            else if (b_init)
+            {
+                for (int idx = 0; idx < n; idx++)
                 {
-                    // Search the lower half
-                    return BinSearchImpl(lower_bound, mid - 1, e);
+                    out[idx] = Bound<false>(keys[idx]);
                 }
-                else // e > data_val
+            }
+            else
+            {
+                GroupLowerBound(keys, n, out);
+            }
+
+            // Turn each lower bound into the result of a binary search
+            const CDA & self = *this;
+
+            for (int idx = 0; idx < n; idx++)
+            {
+                if ((out[idx] >= user_size) || (keys[idx] < self.Access(out[idx])))
                 {
-                    // Search the upper half
-                    return BinSearchImpl(mid + 1, upper_bound, e);
+                    out[idx] = ~out[idx];
                 }
             }
+        }
+
+        /**
+         * Inserts an element into a sorted array, keeping it sorted. The elements between the new
+         * element and the nearer end of the array are moved over by one, using a free slot at that
+         * end, so an insert moves at most half of the elements.
+         *
+         * @param[in] e The element to insert. It goes after any elements equal to it.
+         *
+         * @return The index the element was inserted at.
+         *
+         * @note Still takes O(N) time, as up to N / 2 elements are moved. A #TieredCDA keeps a sorted
+         *       array with O(sqrt(N)) moves per insert, for arrays that are changed often.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time once.
+         */
+        int InsertSorted(elmtype e)
+        {
+            InsertInitValues();
+
+            int const pos = Bound<true>(e);
+
+            if (pos == user_size)
+            {
+                EmplaceEnd(move(e));
+                return pos;
+            }
+            if (pos == 0)
+            {
+                EmplaceFront(move(e));
+                return pos;
+            }
+
+            if (user_size == arr_capacity)
+            {
+                Grow();
+            }
+
+            if (pos < (user_size - pos))
+            {
+                // Open a slot at the front, and move the elements before pos down into it
+                ConstructFront(move(data_array[front_idx]));
+                ShiftDown(1, pos);
+            }
+            else
+            {
+                // Open a slot at the back, and move the elements from pos up into it
+                ConstructEnd(move(data_array[WrapIdx(front_idx + user_size - 1)]));
+                ShiftUp(pos, user_size - 2);
+            }
+
+            data_array[WrapIdx(front_idx + pos)] = move(e);
+
+            return pos;
+        }
+
+        /**
+         * Erases one element equal to e from a sorted array, keeping it sorted. The elements between
+         * it and the nearer end of the array are moved over by one, which is up to N / 2 elements.
+         *
+         * @param[in] e The value to erase.
+         *
+         * @retval true  An element equal to e was erased.
+         * @retval false There was no element equal to e.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first, which takes O(N) time once.
+         */
+        bool EraseSorted(elmtype e)
+        {
+            InsertInitValues();
+
+            int const pos = Bound<false>(e);
+
+            if ((pos == user_size) || (e < data_array[WrapIdx(front_idx + pos)]))
+            {
+                return false;
+            }
+
+            if (pos < (user_size - 1 - pos))
+            {
+                // Close the gap from the front, then delete the moved from front element
+                ShiftUp(0, pos);
+                DelFront();
+            }
+            else
+            {
+                // Close the gap from the back, then delete the moved from back element
+                ShiftDown(pos, user_size - 1);
+                DelEnd();
+            }
+
+            return true;
+        }
+
+        /**
+         * Finds the first element that is not less than e in a sorted array.
+         *
+         * @param[in] e The elmtype value to search for.
+         *
+         * @return The index of the element, or the size of the array if there is none.
+         *
+         * @note Uses a branchless binary search. Unless the array was initialized in constant time,
+         *       the first element of the second segment picks the segment to search, so the search
+         *       itself runs on a plain pointer with no wrap around.
+         */
+        int LowerBound(elmtype e)
+        {
+            return Bound<false>(e);
+        }
 
-            if ((mid_idx + 1) == ((front_idx + user_size) % arr_capacity))
-            {
-                // No larger elemern, returning the bitwise complement of the size.
-                return ~user_size;
-            }
-            else
-            {
-                // Returning the bitwise complement of the next element greater.
-                return (~(mid + 1));
-            }
+        /**
+         * Finds the first element that is greater than e in a sorted array.
+         *
+         * @param[in] e The elmtype value to search for.
+         *
+         * @return The index of the element, or the size of the array if there is none.
+         */
+        int UpperBound(elmtype e)
+        {
+            return Bound<true>(e);
+        }
+
+        /**
+         * Finds the elements equal to e in a sorted array.
+         *
+         * @param[in] e The elmtype value to search for.
+         *
+         * @return The index of the first element equal to e and of the element just past the last
+         *         one, which are equal if there is no such element.
+         */
+        pair<int, int> EqualRange(elmtype e)
+        {
+            return make_pair(Bound<false>(e), Bound<true>(e));
         }
 
         /**
@@ -696,20 +2169,30 @@ class CDA
          *
          * @param[in] e The elmtype value to look for in the array.
          *
-         * @return The index of the item if found, otherwise a negative number that is the bitwise
-         *         complement of the index of the next element that is larger than e or, if there is
-         *         no larger element, the bitwise complement of size.
+         * @return The index of the first item equal to e if found, otherwise a negative number that is
+         *         the bitwise complement of the index of the next element that is larger than e or, if
+         *         there is no larger element, the bitwise complement of size.
+         *
+         * @note For a sorted array that is searched many times without being changed, an
+         *       #EytzingerIndex built from cbegin() and cend() is faster.
          */
         int BinSearch(elmtype e)
         {
-            return BinSearchImpl(0, user_size - 1, e);
+            int const idx = Bound<false>(e);
+
+            if ((idx < user_size) && !(e < static_cast<const CDA &>(*this).Access(idx)))
+            {
+                return idx;
+            }
+
+            return ~idx;
         }
 
         /**
          * Functions that returns a value from the #data_array
          *
          * @param[in] idx The index to be used directly to access elements in the #data_array, and
-         *                the #idx_array if needed.
+         *                the #tracker if needed.
          *
          * @return The value at the given index.
          */
@@ -733,380 +2216,360 @@ class CDA
         }
 
         /**
-         * Function that merges two sorted arrays together.
+         * Bottom-up merge sort implementation. Runs that are already in order are found first, short
+         * runs are extended with an insertion sort, and then neighbouring runs are merged together
+         * without any recursion.
+         *
+         * @param[in] lower_bound The lower index of the section being sorted.
+         * @param[in] upper_bound The upper index of the section being sorted.
          *
-         * @param[in] lower_bound The lower index of the section being merged.
-         * @param[in] mid         The middle index of the section being merged.
-         * @param[in] upper_bound The upper index of the section being sorted.d
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first.
          */
-        void Merge(int lower_bound, int mid, int upper_bound)
+        void MergeSort(int lower_bound, int upper_bound)
         {
-            elmtype temp_data_arr[upper_bound - lower_bound + 1]; ///< Stores the data to be copied over
-            int temp_idx_arr[upper_bound - lower_bound + 1];      ///< Stores the idx info if needed
-            bool use_idx_arr[upper_bound - lower_bound + 1];      ///< Stores boolean value to determine if the idx value should be used.
-
-            int i = lower_bound; ///< Start of the left section
-            int j = mid + 1;     ///< Start of the right section
-            int k = 0;           ///< Index for the temp array
+            InsertInitValues();
 
-            // While there are still values in both arrays
-            while (i <= mid && j <= upper_bound)
+            if (lower_bound >= upper_bound)
             {
-                // If the value in the left half of the array is less than or equal to the value in
-                // the right add it to the temp array. Otherwise add the value in right half of the array.
-                if (GetVal((front_idx + i) % arr_capacity) <= GetVal((front_idx + j) % arr_capacity))
-                {
-                    temp_data_arr[k] = GetVal((front_idx + i) % arr_capacity);
-
-                    if (b_init)
-                    {
-                        if (WasChanged((front_idx + i) % arr_capacity))
-                        {
-                            temp_idx_arr[k] = idx_array[(front_idx + i) % arr_capacity];
-                            use_idx_arr[k]  = true;
-                        }
-                        else
-                        {
-                            use_idx_arr[k] = false;
-                        }
-                    }
-                    k++; //< Increment the index of the temp array
-                    i++; //< Increment the index for the left side of the array
-                }
-                else
-                {
-                    temp_data_arr[k] = GetVal((front_idx + j) % arr_capacity);
-
-                    if (b_init)
-                    {
-                        if (WasChanged((front_idx + j) % arr_capacity))
-                        {
-                            temp_idx_arr[k] = idx_array[(front_idx + j) % arr_capacity];
-                            use_idx_arr[k]  = true;
-                        }
-                        else
-                        {
-                            use_idx_arr[k] = false;
-                        }
-                    }
-                    k++; //< Increment the index of the temp array
-                    j++; //< Increment the index for the right side of the array
-                }
+                return;
             }
 
-            // Fill up the temp array with values from the left half of the array
-            while (i <= mid)
+            // The section must be contiguous, so rotate the array if the section wraps around
+            if ((front_idx + upper_bound) >= arr_capacity)
             {
-                temp_data_arr[k] = GetVal((front_idx + i) % arr_capacity);
-                if (b_init)
-                {
-                    if (WasChanged((front_idx + i) % arr_capacity))
-                    {
-                        temp_idx_arr[k] = idx_array[(front_idx + i) % arr_capacity];
-                        use_idx_arr[k]  = true;
-                    }
-                    else
-                    {
-                        use_idx_arr[k] = false;
-                    }
-                }
-                k++; //< Increment the index of the temp array
-                i++; //< Increment the index for the left side of the array
+                Linearize();
             }
 
-            // Fill up the temp array with values from the right half of the array
-            while (j <= upper_bound)
-            {
-                temp_data_arr[k] = GetVal((front_idx + j) % arr_capacity);
+            int const section_len = upper_bound - lower_bound + 1;
 
-                if (b_init)
-                {
-                    if (WasChanged((front_idx + j) % arr_capacity))
-                    {
-                        temp_idx_arr[k] = idx_array[(front_idx + j) % arr_capacity];
-                        use_idx_arr[k]  = true;
-                    }
-                    else
-                    {
-                        use_idx_arr[k] = false;
-                    }
-                }
-                k++; //< Increment the index of the temp array
-                j++; //< Increment the index for the right side of the array
-            }
+            // The elements are sorted in the scratch array, and the section they left is used as the
+            // second buffer
+            elmtype * section = data_array + front_idx + lower_bound;
+            elmtype * scratch = BottomUpMergeSorter<elmtype>::MoveToScratch(section, section_len);
+            elmtype * sorted  = BottomUpMergeSorter<elmtype>::Sort(scratch, section, section_len);
 
-            // Copy the sorted data back into the data_array
-            for (i = lower_bound; i <= upper_bound; i++)
+            // Make sure the sorted elements end up in the data array
+            if (sorted == scratch)
             {
-                data_array[(front_idx + i) % arr_capacity] = temp_data_arr[i - lower_bound];
-
-                if (b_init)
-                {
-                    if (use_idx_arr[i - lower_bound])
-                    {
-                        idx_array[(front_idx + i) % arr_capacity]  = temp_idx_arr[i - lower_bound];
-                        point_array[idx_array[(front_idx  + i) % arr_capacity]] = (front_idx + i) % arr_capacity;
-                    }
-                }
+                move(scratch, scratch + section_len, section);
             }
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(scratch, section_len);
         }
 
         /**
-         * Merge sort implementation.
+         * Sorts the array. Integral and floating point element types are sorted with #RadixSort(),
+         * and all other types are sorted with the merge sort algorithm.
          *
-         * @param[in] lower_bound The lower index of the section being sorted.
-         * @param[in] upper_bound The upper index of the section being sorted.
+         * @note After #Sort() is called, all of the init values will have been inserted into the array.
          */
-        void MergeSort(int lower_bound, int upper_bound)
+        void Sort()
         {
-            // Call recursively until the sections are as small as possible
-            if (lower_bound >= upper_bound)
-            {
-                return;
-            }
-
-            // Find the mid point of the data array
-            int mid = (lower_bound + upper_bound) / 2;
-
-            // Sort the left half of the data array
-            MergeSort(lower_bound, mid);
+            // Store the init values first, so the sort doesn't need to check the init arrays.
+            InsertInitValues();
 
-            // Sort the right half of the data array
-            MergeSort(mid + 1, upper_bound);
-
-            // Merge the two sorted halfs together
-            Merge(lower_bound, mid, upper_bound);
+            SortImpl(integral_constant<bool, RadixKey<elmtype>::b_sortable>());
         }
 
         /**
-         * Performs the merge sort algorithm on the array.
+         * Performs an LSD radix sort on the array, 8 bits per pass. Only available for integral and
+         * floating point element types.
          *
-         * @note After #Sort() is called, all of the init values will have been inserted into the array.
+         * @note Uses one scratch array of #user_size elements, and the elements are moved to the start
+         *       of the #data_array.
+         *
+         * @note After #RadixSort() is called, all of the init values will have been inserted into the
+         *       array.
          */
-        void Sort()
+        void RadixSort()
         {
-            // Recursively sort the data array
-            MergeSort(0, user_size - 1);
+            elmtype * first;
+            elmtype * second;
+            int first_len;
+            int second_len;
 
-            // Init values have been stored in the array, so it can now function as an uninitialized
-            // array.
-            b_init = false;
+            Segments(first, first_len, second, second_len);
 
-            // Freeing unneeded memory
-            if (NULL != idx_array)
+            if (user_size < 2)
             {
-                delete[] idx_array;
-                idx_array = NULL;
+                return;
             }
-            if (NULL != point_array)
+
+            // The radix sort only handles arithmetic types, so the scratch needs no constructing
+            elmtype * scratch = Allocate(user_size);
+
+            if (RadixSorter<elmtype>::Sort(first, first_len, second, second_len, data_array, scratch))
             {
-                delete[] point_array;
-                point_array = NULL;
+                // The sorted elements now start at index 0 of the data array
+                front_idx = 0;
+                back_idx  = (user_size == arr_capacity) ? 0 : user_size;
             }
+
+            Deallocate(scratch);
         }
 
         /**
-         * Function to swap two values of the #idx_array if necessary.
+         * Performs a stable merge sort on the array using multiple threads. Each thread sorts one run
+         * of the array, and then the runs are merged together in parallel.
+         *
+         * @param[in] threads The number of threads to use. If less than 1, the number of hardware
+         *                    threads is used.
          *
-         * @param[in] idx1 The index of the first value to potentially swap.
-         * @param[in] idx2 The index of the second value to potentially swap.
+         * @note Uses one scratch array of #user_size elements. The elements are only moved to the start
+         *       of the #data_array if they wrap around its end.
+         *
+         * @note After #ParallelSort() is called, all of the init values will have been inserted into the
+         *       array.
          */
-        void SwapInitValues(int const idx1, int const idx2)
+        void ParallelSort(int threads)
         {
-            if (WasChanged(idx1) && WasChanged(idx2))
+            // Store the init values first, so the threads only need to work on the data array.
+            InsertInitValues();
+
+            if (user_size < 2)
             {
-                // Do Nothing
+                return;
             }
-            else if (WasChanged(idx1))
-            {
-                swap(idx_array[idx1],
-                     idx_array[idx2]);
 
-                // Since only one of the values have been changed, the point array must be updated.
-                point_array[idx_array[idx2]] = idx2;
+            // The threads need one contiguous block, so only rotate the array if it wraps around
+            if ((front_idx + user_size) > arr_capacity)
+            {
+                Linearize();
             }
-            else if (WasChanged(idx2))
+
+            // The elements are sorted in the scratch array, and the section they left is used as the
+            // second buffer
+            elmtype * section = data_array + front_idx;
+            elmtype * scratch = BottomUpMergeSorter<elmtype>::MoveToScratch(section, user_size);
+
             {
-                swap(idx_array[idx2],
-                     idx_array[idx1]);
+                ThreadPool pool(threads);
+
+                elmtype * sorted = ParallelMergeSorter<elmtype>::Sort(scratch, section, user_size, pool);
 
-                // Since only one of the values have been changed, the point array must be updated.
-                point_array[idx_array[idx1]] = idx1;
+                // Make sure the sorted elements end up in the data array
+                if (sorted == scratch)
+                {
+                    move(scratch, scratch + user_size, section);
+                }
             }
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(scratch, user_size);
         }
 
         /**
-         * Generates a random partition value and swaps it to the end of the array.
+         * Merges several sorted arrays into a new sorted array with a loser tree, so each element is
+         * compared about log2 k times and written once. The new array is allocated once, at its final
+         * size, and each input is read through its contiguous segments.
+         *
+         * @param[in] inputs The sorted arrays to merge. Equal elements are taken from the earlier
+         *                   input first.
+         * @param[in] k      The number of arrays.
          *
-         * @param[in] start The index to be used as the starting position.
-         * @param[in] end   The index to be used as the ending position.
+         * @return The merged array, which starts at index 0 of its #data_array.
          *
-         * @return A pivot index to be used in they quickselect algorithm.
+         * @note If an input was initialized in constant time, its init values are inserted first.
          */
-        int RandomPartition(int const start, int const end)
+        static CDA MergeSorted(CDA ** inputs, int k)
         {
-            // Calculate a random index within the range.
-            int i = (rand() % (end - start + 1)) + start;
+            return MergeSortedImpl(inputs, k, 1);
+        }
 
-            if (b_init)
+        /**
+         * Merges several sorted arrays into a new sorted array like #MergeSorted(), with the output
+         * split into one chunk per thread. The start of each chunk in every input is found by
+         * co-ranking, and the chunks are then merged concurrently.
+         *
+         * @param[in] inputs  The sorted arrays to merge. Equal elements are taken from the earlier
+         *                    input first.
+         * @param[in] k       The number of arrays.
+         * @param[in] threads The number of threads to merge with.
+         *
+         * @return The merged array.
+         */
+        static CDA ParallelMergeSorted(CDA ** inputs, int k, int threads)
+        {
+            return MergeSortedImpl(inputs, k, max(1, threads));
+        }
+
+        /**
+         * Function that selects the kth smallest element in the array.
+         *
+         * @note The positions of the elements in the array are likely to change. Afterwards, the kth
+         *       smallest element is at index k - 1, with no larger element before it and no smaller
+         *       element after it.
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first.
+         *
+         * @param[in] k An integer signaling which smallest element the user is looking for.
+         *
+         * @return The kth smallest element in the array, or #ref_val if the #error_policy rejects k.
+         */
+        elmtype Select(int k)
+        {
+            if (!error_policy::InBounds(k - 1, user_size))
             {
-                SwapInitValues((front_idx + end) % arr_capacity,
-                               (front_idx + i) % arr_capacity);
+                return ref_val;
             }
 
-            // Move the random value to the last index.
-            swap(data_array[(front_idx + end) % arr_capacity],
-                 data_array[(front_idx + i) % arr_capacity]);
+            elmtype * section = SelectSection();
 
-            return Partition(start, end);
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(k));
+            selector.Select(section, 0, user_size, k - 1);
+
+            return section[k - 1];
         }
 
         /**
-         * Partitions the block of the array using the start and end points.
+         * Function that selects both the k1th and k2th smallest elements in the array, leaving the array
+         * partitioned around both of them.
+         *
+         * @note Afterwards, the k1th smallest element is at index k1 - 1 and the k2th smallest element is
+         *       at index k2 - 1. No element before either of them is larger, and no element after either
+         *       of them is smaller.
          *
-         * @param[in] start The index to be used as the starting position.
-         * @param[in] end   The index to be used as the ending position.
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first.
          *
-         * @return The index of the pivot element.
+         * @param[in] k1 The lower rank, starting at 1.
+         * @param[in] k2 The upper rank, which must not be less than k1.
          */
-        int Partition(int const start, int const end)
+        void SelectRange(int k1, int k2)
         {
-            elmtype pivot_element;
+            // k2 must be a rank of the array, and k1 a rank no greater than k2
+            if (!error_policy::InBounds(k2 - 1, user_size) || !error_policy::InBounds(k1 - 1, k2))
+            {
+                return;
+            }
 
-            // Get the pivot element from the end of the section.
-            if (b_init)
+            elmtype * section = SelectSection();
+
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(k1));
+
+            // Select the lower rank, and then the upper rank out of what is left above it
+            selector.Select(section, 0, user_size, k1 - 1);
+
+            if (k2 > k1)
             {
-                if (WasChanged((front_idx + end) % arr_capacity))
-                {
-                    pivot_element = data_array[(front_idx + end) % arr_capacity];
-                }
-                else
+                selector.Select(section, k1, user_size, k2 - 1);
+            }
+        }
+
+        /**
+         * Function that selects several ranks of the array at once, such as a set of percentiles. Each
+         * rank only partitions the part of the array between its neighbouring ranks, so m ranks take
+         * about O(N log m) time rather than m calls to #Select().
+         *
+         * @note The positions of the elements in the array are likely to change. Afterwards, every
+         *       selected rank k is at index k - 1, partitioned as it would be by #Select().
+         *
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first.
+         *
+         * @param[in]  ranks The ranks to select, starting at 1, in any order.
+         * @param[in]  n     The number of ranks.
+         * @param[out] out   Set to the element of each rank, in the same order as #ranks.
+         */
+        void SelectMany(const int * ranks, int n, elmtype * out)
+        {
+            for (int idx = 0; idx < n; idx++)
+            {
+                if (!error_policy::InBounds(ranks[idx] - 1, user_size))
                 {
-                    pivot_element = init_val;
+                    return;
                 }
             }
-            else
+
+            if (n < 1)
             {
-                pivot_element = data_array[(front_idx + end) % arr_capacity];
+                return;
             }
 
-            int i = start - 1;
+            // The selector needs the indexes in increasing order without any repeats
+            int * sorted_idxs = new int[n];
 
-            // Compare each element in the section to the pivot element.
-            for (int j = start; j <= (end - 1); j++)
+            for (int idx = 0; idx < n; idx++)
             {
-                elmtype data_val;
+                sorted_idxs[idx] = ranks[idx] - 1;
+            }
 
-                // Get the value to compare against the pivot element.
-                if (b_init)
-                {
-                    if (WasChanged((front_idx + j) % arr_capacity))
-                    {
-                        data_val = data_array[(front_idx + j) % arr_capacity];
-                    }
-                    else
-                    {
-                        data_val = init_val;
-                    }
-                }
-                else
-                {
-                    data_val = data_array[(front_idx + j) % arr_capacity];
-                }
+            sort(sorted_idxs, sorted_idxs + n);
 
-                // If the element is less than or equal to the pivot element
-                if (data_val <= pivot_element)
-                {
-                    i++;
+            int const unique_idxs = static_cast<int>(unique(sorted_idxs, sorted_idxs + n) - sorted_idxs);
 
-                    if (b_init)
-                    {
-                        SwapInitValues((front_idx + i) % arr_capacity,
-                                       (front_idx + j) % arr_capacity);
-                    }
+            elmtype * section = SelectSection();
 
-                    swap(data_array[(front_idx + i) % arr_capacity],
-                         data_array[(front_idx + j) % arr_capacity]);
-                }
-            }
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(n));
+            selector.SelectMany(section, 0, user_size, sorted_idxs, unique_idxs);
 
-            if (b_init)
+            for (int idx = 0; idx < n; idx++)
             {
-                SwapInitValues((front_idx + i + 1) % arr_capacity,
-                               (front_idx + end) % arr_capacity);
+                out[idx] = section[ranks[idx] - 1];
             }
 
-            swap(data_array[(front_idx + i + 1) % arr_capacity],
-                 data_array[(front_idx + end) % arr_capacity]);
-
-            // Returns the index of the pivot element
-            return i + 1;
+            delete[] sorted_idxs;
         }
 
         /**
-         * A function that performs the quickselect algorithm with a random partition.
+         * Sorts only the k smallest elements of the array into the front of it. The kth smallest
+         * element is selected first, which partitions the array around it, and then only the k
+         * elements before it are sorted, so it takes about O(N + k log k) time.
          *
-         * @param[in] start The starting index of the section.
-         * @param[in] end   The ending index of the section.
-         * @param[in] k     An integer signaling which smallest element the user is looking for.
+         * @note Afterwards, indexes 0 to k - 1 hold the k smallest elements in order, and the rest of
+         *       the elements are in no particular order.
          *
-         * @return The kth smallest element in the array.
+         * @note If the array was initialized in constant time, the init values are inserted into the
+         *       array first.
+         *
+         * @param[in] k The number of smallest elements to sort. The whole array is sorted if k is at
+         *              least the size of the array.
          */
-        elmtype QuickSelect(int start, int end, int k)
+        void PartialSort(int k)
         {
-            // If there is only one element in the array, return it.
-            if (start == end)
+            if (k >= user_size)
             {
-                if (b_init)
-                {
-                    if (!WasChanged((front_idx + start) % arr_capacity))
-                    {
-                        return init_val;
-                    }
-                }
-
-                return data_array[(front_idx + start) % arr_capacity];
+                Sort();
+                return;
+            }
+            if (k < 1)
+            {
+                return;
             }
 
-            int pivotIndex = RandomPartition(start, end);
-
-            //< Number of elements less than or equal to the pivot index
-            int i = pivotIndex - start + 1;
+            elmtype * section = SelectSection();
 
-            if (k == i) //< kth smallest element is the pivot
-            {
-                if (b_init)
-                {
-                    if (!WasChanged((front_idx + pivotIndex) % arr_capacity))
-                    {
-                        return init_val;
-                    }
-                }
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(k));
+            selector.Select(section, 0, user_size, k - 1);
 
-                return data_array[(front_idx + pivotIndex) % arr_capacity];
-            }
-            else if (k < i) //< kth smallest element is to the left of the pivot
-            {
-                return QuickSelect(start, pivotIndex - 1, k);
-            }
-            else //kth smallest element is to the right of the pivot
-            {
-                return QuickSelect(pivotIndex + 1, end, k - i);
-            }
+            // The section is contiguous, so sorting the prefix doesn't need to move the array again
+            MergeSort(0, k - 1);
         }
 
         /**
-         * Function that selects the kth smallest element in the array.
+         * Copies the k smallest elements of the array, in order, using #PartialSort().
          *
-         * @note The positions of the elements in the array are likely to change.
+         * @note The array is left partially sorted, as by #PartialSort().
          *
-         * @param[in] k An integer signaling which smallest element the user is looking for.
+         * @param[in]  k   The number of smallest elements wanted.
+         * @param[out] out The array to copy the elements to, which must have room for k elements.
          *
-         * @return The kth smallest element in the array.
+         * @return The number of elements copied, which is less than k only if the array has fewer
+         *         than k elements.
          */
-        elmtype Select(int k)
+        int TopK(int k, elmtype * out)
         {
-            return QuickSelect(0, user_size - 1, k);
+            int const count = max(0, min(k, user_size));
+
+            PartialSort(count);
+
+            for (int idx = 0; idx < count; idx++)
+            {
+                out[idx] = data_array[WrapIdx(front_idx + idx)];
+            }
+
+            return count;
         }
 
         /**
@@ -1118,26 +2581,37 @@ class CDA
          */
         int Search(elmtype e)
         {
-            // Loop through the array looking for the specified value.
+            if (!b_init)
+            {
+                int const first_len  = min(user_size, arr_capacity - front_idx);
+                int const second_len = user_size - first_len;
+
+                // Scan each segment looking for the specified value.
+                int idx = SimdScan<elmtype>::Find(data_array + front_idx, first_len, e);
+
+                if (idx >= 0)
+                {
+                    return idx;
+                }
+
+                idx = SimdScan<elmtype>::Find(data_array, second_len, e);
+
+                return (idx >= 0) ? (first_len + idx) : -1;
+            }
+
+            // Loop through the initialized array looking for the specified value.
             for (int i = 0; i < user_size; i++)
             {
-                int idx_to_check = (front_idx + i) % arr_capacity;
+                int idx_to_check = WrapIdx(front_idx + i);
 
-                if (b_init)
+                if (WasChanged(idx_to_check))
                 {
-                    if (WasChanged(idx_to_check))
-                    {
-                        if (e == data_array[idx_to_check])
-                        {
-                            return i;
-                        }
-                    }
-                    else if (e == init_val)
+                    if (e == data_array[idx_to_check])
                     {
                         return i;
                     }
                 }
-                else if (e == data_array[(front_idx + i) % arr_capacity])
+                else if (e == init_val)
                 {
                     return i;
                 }
@@ -1146,6 +2620,69 @@ class CDA
             return -1;
         }
 
+        /**
+         * Counts the number of elements in the array that are equal to the specified item.
+         *
+         * @param[in] e The elmtype value to count in the array.
+         *
+         * @return The number of elements equal to e.
+         */
+        int Count(elmtype e)
+        {
+            if (b_init)
+            {
+                int count = 0;
+
+                for (int i = 0; i < user_size; i++)
+                {
+                    if (e == GetVal(WrapIdx(front_idx + i)))
+                    {
+                        count++;
+                    }
+                }
+
+                return count;
+            }
+
+            int const first_len  = min(user_size, arr_capacity - front_idx);
+            int const second_len = user_size - first_len;
+
+            return SimdScan<elmtype>::Count(data_array + front_idx, first_len, e) +
+                   SimdScan<elmtype>::Count(data_array, second_len, e);
+        }
+
+        /**
+         * Finds every element in the array that is equal to the specified item.
+         *
+         * @param[in]  e   The elmtype value to look for in the array.
+         * @param[out] out The array that the index of each match is added to the end of, in order.
+         */
+        template <typename out_policy>
+        void FindAll(elmtype e, CDA<int, out_policy> & out)
+        {
+            if (b_init)
+            {
+                for (int i = 0; i < user_size; i++)
+                {
+                    if (e == GetVal(WrapIdx(front_idx + i)))
+                    {
+                        out.AddEnd(i);
+                    }
+                }
+
+                return;
+            }
+
+            int const first_len  = min(user_size, arr_capacity - front_idx);
+            int const second_len = user_size - first_len;
+
+            FindAllVisitor<out_policy> visit_first  = { &out, 0 };
+            FindAllVisitor<out_policy> visit_second = { &out, first_len };
+
+            SimdScan<elmtype>::ForEachMatch(data_array + front_idx, first_len, e, visit_first);
+            SimdScan<elmtype>::ForEachMatch(data_array, second_len, e, visit_second);
+        }
+
         /*********************************
          * Debug Functions
          *********************************/
@@ -1155,7 +2692,7 @@ class CDA
          */
         void InitCheck()
         {
-            cout << "Elements Changed: " << elms_changed       << endl;
+            cout << "Elements Changed: " << tracker.Changed()  << endl;
             cout << "Init Value:       " << init_val           << endl;
         }
 
@@ -1171,13 +2708,14 @@ class CDA
         }
 
         /**
-         * Displays the contents of the data array.
+         * Displays the contents of the data array. Slots that were never changed after the array was
+         * initialized in constant time are shown as the #init_val.
          */
         void DisplayArrayContents()
         {
             for (int idx = 0; idx < user_size; idx++)
             {
-                cout << data_array[(front_idx + idx) % arr_capacity] << " ";
+                cout << Read(idx) << " ";
             }
 
             cout << endl;
@@ -1188,18 +2726,9 @@ class CDA
          */
         void DisplayInitArrays()
         {
-            for (int idx = 0; idx < arr_capacity; idx++)
-            {
-                cout << idx_array[idx] << " ";
-            }
-
-            cout << endl;
-
-            for (int idx = 0; idx < elms_changed; idx++)
-            {
-                cout << point_array[idx] << " ";
-            }
-
-            cout << endl;
+            tracker.Display();
         }
 };
+
+// End of include guard for CDA_CPP
+#endif
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Returns true if every result of a batch search matches a single BinSearch
+template <typename array_type>
+bool batch_matches(array_type & A, vector<int> & keys)
+{
+	vector<int> out(keys.size() + 1, 12345);
+	A.BinSearchBatch(keys.data(), static_cast<int>(keys.size()), out.data());
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		if (out[i] != A.BinSearch(keys[i])) return false;
+	}
+
+	// Nothing is written past the end of the batch
+	return out[keys.size()] == 12345;
+}
+
+// Builds a sorted array of n values with duplicates, wrapped around the end of its storage
+void fill_sorted(CDA<int> & A, int n)
+{
+	vector<int> v(n);
+	for (int i = 0; i < n; i++) v[i] = rand() % (2 * n + 1);
+	sort(v.begin(), v.end());
+
+	fill_wrapped(A, v);
+}
+
+// Unsorted, sorted and reverse sorted batches of every size up to 70, on arrays of many sizes
+void test1()
+{
+	int const sizes[] = {0, 1, 2, 15, 16, 17, 100, 1000, 100000};
+	bool b_ok = true;
+
+	for (int n : sizes)
+	{
+		CDA<int> A;
+		fill_sorted(A, n);
+
+		for (int count = 0; count <= 70; count++)
+		{
+			vector<int> keys(count);
+			for (int i = 0; i < count; i++) keys[i] = rand() % (2 * n + 3) - 1;
+
+			b_ok = b_ok && batch_matches(A, keys);
+			sort(keys.begin(), keys.end());
+			b_ok = b_ok && batch_matches(A, keys);
+			reverse(keys.begin(), keys.end());
+			b_ok = b_ok && batch_matches(A, keys);
+		}
+	}
+	check(b_ok, "batches match BinSearch");
+}
+
+// Large batches, including repeated keys, and an array initialized in constant time
+void test2()
+{
+	CDA<int> A;
+	fill_sorted(A, 200000);
+
+	vector<int> keys(50000);
+	for (int & key : keys) key = rand() % 400001;
+	check(batch_matches(A, keys), "a large unsorted batch");
+	sort(keys.begin(), keys.end());
+	check(batch_matches(A, keys), "a large sorted batch");
+
+	vector<int> same(1000, A[500]);
+	check(batch_matches(A, same), "a batch of one repeated key");
+
+	CDA<int> B(5000, 7);
+	B.AddFront(3);
+	B.AddEnd(9);
+	vector<int> init_keys;
+	for (int i = 0; i < 200; i++) init_keys.push_back(rand() % 12);
+	check(batch_matches(B, init_keys), "an unsorted batch on an initialized array");
+	sort(init_keys.begin(), init_keys.end());
+	check(batch_matches(B, init_keys), "a sorted batch on an initialized array");
+}
+
+int main()
+{
+	srand(22);
+	test1();
+	test2();
+	return report("BinSearchBatch");
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Returns how many elements from the front of the array are stored one after another
+template <typename array_type>
+int contiguous_front(array_type &A)
+{
+	int count = 0;
+	while ((count < A.Length()) && (&A[count] == &A[0] + count)) count++;
+	return count;
+}
+
+// Random range adds and drops at both ends, checked against a deque
+void test1()
+{
+	CDA<string> A;
+	deque<string> ref;
+	bool b_ok = true;
+
+	for (int op = 0; op < 20000; op++)
+	{
+		int const choice = rand() % 6;
+		int const n = rand() % 40 - 2;
+		vector<string> src;
+		for (int i = 0; i < max(0, n); i++) src.push_back(to_string(op) + "." + to_string(i));
+
+		if (choice == 0) { A.AppendRange(src.data(), n); ref.insert(ref.end(), src.begin(), src.end()); }
+		else if (choice == 1) { A.PrependRange(src.data(), n); ref.insert(ref.begin(), src.begin(), src.end()); }
+		else if (choice == 2)
+		{
+			A.DropFront(n);
+			ref.erase(ref.begin(), ref.begin() + max(0, min(n, static_cast<int>(ref.size()))));
+		}
+		else if (choice == 3)
+		{
+			A.DropBack(n);
+			ref.erase(ref.end() - max(0, min(n, static_cast<int>(ref.size()))), ref.end());
+		}
+		else if (choice == 4) { A.AddEnd(src.empty() ? "one" : src[0]); ref.push_back(src.empty() ? "one" : src[0]); }
+		else if (!ref.empty()) { A.DelFront(); ref.pop_front(); }
+
+		if ((op % 100) == 0) b_ok = b_ok && same(A, ref);
+	}
+	check(b_ok && same(A, ref), "range operations match a deque");
+
+	A.DropFront(A.Length() + 10);
+	check(A.Length() == 0, "dropping more than the size empties the array");
+}
+
+// Ranges taken from the array itself, which may be moved by the resize the add makes
+void test2()
+{
+	bool b_ok = true;
+
+	for (int trial = 0; trial < 500; trial++)
+	{
+		CDA<string> A;
+		deque<string> ref;
+		int const len = 1 + rand() % 100;
+		for (int i = 0; i < len; i++) { A.AddFront(to_string(i)); ref.push_front(to_string(i)); }
+
+		int const n = 1 + rand() % contiguous_front(A);
+		vector<string> copy(ref.begin(), ref.begin() + n);
+
+		if ((trial % 2) == 0) { A.AppendRange(&A[0], n); ref.insert(ref.end(), copy.begin(), copy.end()); }
+		else { A.PrependRange(&A[0], n); ref.insert(ref.begin(), copy.begin(), copy.end()); }
+
+		b_ok = b_ok && same(A, ref);
+	}
+	check(b_ok, "ranges from the array itself");
+}
+
+// Ranges added to and dropped from an array initialized in constant time
+void test3()
+{
+	CDA<int> A(1000, 5);
+	deque<int> ref(1000, 5);
+	vector<int> src;
+	for (int i = 0; i < 300; i++) src.push_back(i);
+
+	A.AppendRange(src.data(), 300);
+	ref.insert(ref.end(), src.begin(), src.end());
+	A.PrependRange(src.data(), 300);
+	ref.insert(ref.begin(), src.begin(), src.end());
+	A.DropFront(450);
+	ref.erase(ref.begin(), ref.begin() + 450);
+	A.DropBack(450);
+	ref.erase(ref.end() - 450, ref.end());
+	A.AppendRange(src.data(), 300);
+	ref.insert(ref.end(), src.begin(), src.end());
+
+	check(same(A, ref), "range operations on an initialized array");
+}
+
+int main()
+{
+	srand(14);
+	test1();
+	test2();
+	test3();
+	return report("BulkOps");
+}
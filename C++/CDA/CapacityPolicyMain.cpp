@@ -0,0 +1,120 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+typedef CDA<int, GeneralCapacity>    general_type;
+typedef CDA<int, PowerOfTwoCapacity> power_type;
+
+bool is_power_of_two(int n)
+{
+	return (n > 0) && ((n & (n - 1)) == 0);
+}
+
+// Runs one random operation on an array and the reference deque
+template <typename array_type>
+void random_op(array_type &A, deque<int> &ref, int choice, int value, int count)
+{
+	vector<int> src(count, value);
+	int const size = static_cast<int>(ref.size());
+
+	switch (choice)
+	{
+		case 0: A.AddEnd(value); ref.push_back(value); break;
+		case 1: A.AddFront(value); ref.push_front(value); break;
+		case 2: if (size > 0) { A.DelEnd(); ref.pop_back(); } break;
+		case 3: if (size > 0) { A.DelFront(); ref.pop_front(); } break;
+		case 4: A.AppendRange(src.data(), count); ref.insert(ref.end(), src.begin(), src.end()); break;
+		case 5: A.PrependRange(src.data(), count); ref.insert(ref.begin(), src.begin(), src.end()); break;
+		case 6: A.DropFront(count); ref.erase(ref.begin(), ref.begin() + min(count, size)); break;
+		case 7: A.DropBack(count); ref.erase(ref.end() - min(count, size), ref.end()); break;
+		case 8: A.Reserve(value % 300); break;
+		case 9: A.ShrinkToFit(); break;
+		default: if (size > 0) { A[value % size] = -value; ref[value % size] = -value; } break;
+	}
+}
+
+// The same random operations on both capacity policies give the same contents, with the wrap done
+// by a mask for the power of two capacities
+void test1()
+{
+	bool b_ok = true;
+	bool b_power_ok = true;
+
+	for (int round = 0; round < 4; round++)
+	{
+		general_type G;
+		power_type P;
+		deque<int> ref;
+
+		// The early rounds grow, and the later ones shrink
+		int const del_weight = 2 + round;
+
+		for (int op = 0; op < 20000; op++)
+		{
+			int choice = rand() % 11;
+			if ((choice == 4) || (choice == 5)) choice = (rand() % del_weight == 0) ? choice : choice + 2;
+			int const value = rand();
+			int const count = rand() % 40;
+
+			deque<int> ref_p(ref);
+			random_op(G, ref, choice, value, count);
+			random_op(P, ref_p, choice, value, count);
+
+			b_power_ok = b_power_ok && is_power_of_two(P.Capacity()) && (P.Capacity() >= P.Length());
+			if ((op % 50) == 0) b_ok = b_ok && same(G, ref) && same(P, ref) && (G.Search(ref.empty() ? 0 : ref[0]) == P.Search(ref.empty() ? 0 : ref[0]));
+		}
+		b_ok = b_ok && same(G, ref) && same(P, ref);
+	}
+	check(b_ok, "both capacity policies give the same contents");
+	check(b_power_ok, "the capacity stays a power of two");
+}
+
+// Every way of setting the capacity rounds it up to a power of two
+void test2()
+{
+	bool b_ok = true;
+
+	for (int n = 1; n < 2000; n += 37)
+	{
+		power_type A(n);
+		power_type B(n, 5);
+		power_type C;
+		C.Reserve(n);
+		power_type D(n);
+		D.ShrinkToFit();
+
+		b_ok = b_ok && is_power_of_two(A.Capacity()) && (A.Capacity() >= n) && (A.Capacity() < 2 * n);
+		b_ok = b_ok && (B.Capacity() == A.Capacity()) && (C.Capacity() == A.Capacity()) && (D.Capacity() == A.Capacity());
+		b_ok = b_ok && (B.Length() == n) && (B[n - 1] == 5);
+	}
+	check(b_ok, "sizes are rounded up to a power of two");
+
+	// A growth factor that isn't 2 still gives power of two capacities
+	ResizePolicy policy;
+	policy.growth_factor = 1.5;
+	power_type E;
+	E.SetResizePolicy(policy);
+	for (int i = 0; i < 5000; i++)
+	{
+		E.AddFront(i);
+		b_ok = b_ok && is_power_of_two(E.Capacity());
+	}
+	while (E.Length() > 0)
+	{
+		E.DelEnd();
+		b_ok = b_ok && is_power_of_two(E.Capacity());
+	}
+	check(b_ok, "growth and shrinking keep a power of two");
+}
+
+int main()
+{
+	srand(1);
+	test1();
+	test2();
+	return report("CapacityPolicy");
+}
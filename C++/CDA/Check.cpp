@@ -0,0 +1,123 @@
+/**
+ * @file Check.cpp
+ *
+ * This file implements the checks shared by the test drivers of the circular dynamic arrays. Each
+ * driver runs its tests, calls #check() for every result it verifies, and returns #report() from
+ * main, so the build fails a test run as soon as one check fails. It also holds the fixtures the
+ * drivers share: #fill_wrapped() builds an array that wraps around the end of its storage, and
+ * #same() compares an array against a reference container.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for Check.cpp
+#ifndef CHECK_CPP
+#define CHECK_CPP
+
+#include <iostream>
+
+using namespace std;
+
+int checks_run    = 0; ///< The number of checks made so far.
+int checks_failed = 0; ///< The number of checks that failed.
+
+/**
+ * Records the result of one check, and prints a message if it failed.
+ *
+ * @param[in] b_ok The result of the check.
+ * @param[in] what A description of what was checked.
+ */
+void check(bool b_ok, const char * what)
+{
+	checks_run++;
+
+	if (!b_ok)
+	{
+		checks_failed++;
+		cout << "FAILED: " << what << endl;
+	}
+}
+
+/**
+ * Prints a summary of the checks.
+ *
+ * @param[in] name The name of the driver.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int report(const char * name)
+{
+	cout << name << ": " << (checks_run - checks_failed) << " of " << checks_run << " checks passed" << endl;
+
+	return (checks_failed == 0) ? 0 : 1;
+}
+
+/**
+ * Reads an element with Read() if the array has it, so that reading a copy-on-write array doesn't
+ * clone it.
+ */
+template <typename array_type>
+auto read_elm(array_type & A, int idx, int) -> decltype(A.Read(idx))
+{
+	return A.Read(idx);
+}
+
+/**
+ * Reads an element with operator[], for the arrays that don't have Read().
+ */
+template <typename array_type>
+auto read_elm(array_type & A, int idx, long) -> decltype(A[idx])
+{
+	return A[idx];
+}
+
+/**
+ * Adds values to an empty array so that it holds them in order, wrapped around the end of its
+ * storage. The back half is added at the end, and then the front half at the front.
+ *
+ * @param[in,out] A      The array to fill.
+ * @param[in]     values The values, in a container with size() and operator[].
+ */
+template <typename array_type, typename ref_type>
+void fill_wrapped(array_type & A, const ref_type & values)
+{
+	int const n = static_cast<int>(values.size());
+
+	for (int i = n / 2; i < n; i++)
+	{
+		A.AddEnd(values[i]);
+	}
+
+	for (int i = (n / 2) - 1; i >= 0; i--)
+	{
+		A.AddFront(values[i]);
+	}
+}
+
+/**
+ * Returns true if an array holds the same elements as a reference container, in the same order.
+ *
+ * @param[in] A   The array, which needs Length() and either Read() or operator[].
+ * @param[in] ref The reference, in a container with size() and operator[].
+ */
+template <typename array_type, typename ref_type>
+bool same(array_type & A, const ref_type & ref)
+{
+	if (A.Length() != static_cast<int>(ref.size()))
+	{
+		return false;
+	}
+
+	for (int i = 0; i < A.Length(); i++)
+	{
+		if (!(read_elm(A, i, 0) == ref[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// End of include guard for CHECK_CPP
+#endif
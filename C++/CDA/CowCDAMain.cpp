@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+using namespace std;
+#include "../CowCDA.cpp"
+#include "Check.cpp"
+
+// Copies share the array, and reads through any of them don't clone it
+void test1()
+{
+	CowCDA<int> A;
+	for (int i = 0; i < 1000; i++) A.AddEnd(rand() % 100);
+
+	check(!A.Shared(), "a new array is not shared");
+
+	CowCDA<int> B(A);
+	CowCDA<int> C;
+	C = A;
+
+	check(A.Shared() && B.Shared() && C.Shared(), "copies share the array");
+	check(&A.Read(0) == &B.Read(0) && &A.Read(0) == &C.Read(0), "copies read the same storage");
+
+	long long sum = 0;
+	B.ForEach([&sum](const int & e) { sum += e; });
+	int const count = B.Count(50);
+	int const found = B.Search(50);
+	vector<int> all;
+	for (int i = 0; i < B.Length(); i++) all.push_back(B.Read(i));
+
+	check(B.Shared() && (&A.Read(0) == &B.Read(0)), "reads don't clone the array");
+	check((found < 0) == (count == 0), "Search and Count agree");
+
+	long long ref_sum = 0;
+	for (int e : all) ref_sum += e;
+	check(sum == ref_sum, "ForEach visits every element");
+
+	C.Sort();
+	check(C.Shared() == false && B.Shared(), "sorting clones the array");
+	for (int i = 0; i < 100; i++)
+	{
+		int const key = rand() % 100;
+		int const idx = C.BinSearch(key);
+		check((idx >= 0) == (B.Count(key) > 0), "BinSearch finds the keys in the sorted copy");
+	}
+	check(&A.Read(0) == &B.Read(0), "the other copies still share");
+}
+
+// Random changes to copies never show through to the snapshots taken before them
+void test2()
+{
+	vector<CowCDA<int>> snaps;
+	vector<deque<int>>  refs;
+
+	CowCDA<int> A;
+	deque<int>  ref;
+	bool b_ok = true;
+
+	for (int op = 0; op < 20000; op++)
+	{
+		int const choice = rand() % 8;
+		int const value  = rand();
+
+		if ((op % 1000) == 0)
+		{
+			snaps.push_back(A);
+			refs.push_back(ref);
+			b_ok = b_ok && (A.Length() == 0 || A.Shared());
+		}
+
+		if (choice == 0) { A.AddEnd(value); ref.push_back(value); }
+		else if (choice == 1) { A.AddFront(value); ref.push_front(value); }
+		else if ((choice == 2) && !ref.empty()) { A.DelEnd(); ref.pop_back(); }
+		else if ((choice == 3) && !ref.empty()) { A.DelFront(); ref.pop_front(); }
+		else if (!ref.empty())
+		{
+			int const idx = rand() % static_cast<int>(ref.size());
+			A[idx] = value;
+			ref[idx] = value;
+		}
+	}
+
+	b_ok = b_ok && same(A, ref);
+	for (size_t i = 0; i < snaps.size(); i++)
+	{
+		b_ok = b_ok && same(snaps[i], refs[i]);
+	}
+	check(b_ok, "snapshots are isolated from later changes");
+
+	// Writing through a snapshot leaves the array it was taken from alone
+	CowCDA<int> D(A);
+	D.AddEnd(1);
+	D.At(0) = -1;
+	check(!A.Shared() && !D.Shared() && same(A, ref), "changes to a copy don't change the original");
+}
+
+int main()
+{
+	srand(19);
+	test1();
+	test2();
+	return report("CowCDA");
+}
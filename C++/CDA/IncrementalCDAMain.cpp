@@ -0,0 +1,189 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string>
+using namespace std;
+#include "../IncrementalCDA.cpp"
+#include "Check.cpp"
+
+long moves = 0; // The number of element copies and moves made so far
+
+// An element that counts every copy and move made of it
+struct Counted
+{
+	int value;
+
+	Counted() : value(0) {}
+	Counted(int v) : value(v) {}
+	Counted(const Counted &other) : value(other.value) { moves++; }
+	Counted(Counted &&other) : value(other.value) { moves++; }
+	Counted& operator=(const Counted &other) { value = other.value; moves++; return *this; }
+	Counted& operator=(Counted &&other) { value = other.value; moves++; return *this; }
+	bool operator==(int v) const { return value == v; }
+};
+
+// Each operation moves the added element and at most 4 old elements over to the new storage. An add
+// that starts a resize builds the element once more first, in case it refers to the array itself.
+const long max_moves_per_op = 6;
+
+// Runs random adds and deletes at both ends, checking the moves made by each one
+void run_phase(IncrementalCDA<Counted> &A, deque<int> &ref, int ops, int add_chance, long &max_moves, bool &b_ok)
+{
+	for (int op = 0; op < ops; op++)
+	{
+		Counted const value(rand());
+		long const moves_before = moves;
+
+		if (ref.empty() || ((rand() % 100) < add_chance))
+		{
+			if (rand() % 2) { A.AddEnd(value); ref.push_back(value.value); }
+			else { A.AddFront(value); ref.push_front(value.value); }
+		}
+		else
+		{
+			if (rand() % 2) { A.DelEnd(); ref.pop_back(); }
+			else { A.DelFront(); ref.pop_front(); }
+		}
+
+		max_moves = max(max_moves, moves - moves_before);
+
+		// The contents are checked often while a resize is in progress
+		if (A.Resizing() ? (op % 7 == 0) : (op % 1000 == 0)) b_ok = b_ok && same(A, ref);
+	}
+}
+
+void test1()
+{
+	// Phases that grow and shrink the array, so resizes start with the front in every position
+	IncrementalCDA<Counted> A;
+	deque<int> ref;
+	long max_moves = 0;
+	bool b_ok = true;
+
+	int const add_chances[] = {90, 60, 10, 40, 95, 5, 55, 45};
+
+	for (int round = 0; round < 3; round++)
+	{
+		for (int add_chance : add_chances) run_phase(A, ref, 30000, add_chance, max_moves, b_ok);
+	}
+
+	check(b_ok && same(A, ref), "contents match a deque");
+	check(max_moves <= max_moves_per_op, "O(1) moves per operation");
+	cout << "Most moves in one operation: " << max_moves << endl;
+}
+
+void test2()
+{
+	// Grow then shrink all the way down, alternating ends each time
+	IncrementalCDA<Counted> A;
+	deque<int> ref;
+	long max_moves = 0;
+	bool b_ok = true;
+
+	for (int i = 0; i < 100000; i++)
+	{
+		long const moves_before = moves;
+		if (i % 2) { A.AddFront(Counted(i)); ref.push_front(i); }
+		else { A.AddEnd(Counted(i)); ref.push_back(i); }
+		max_moves = max(max_moves, moves - moves_before);
+	}
+	b_ok = same(A, ref);
+
+	while (!ref.empty())
+	{
+		long const moves_before = moves;
+		if (ref.size() % 3) { A.DelFront(); ref.pop_front(); }
+		else { A.DelEnd(); ref.pop_back(); }
+		max_moves = max(max_moves, moves - moves_before);
+		if (ref.size() % 997 == 0) b_ok = b_ok && same(A, ref);
+	}
+
+	check(b_ok && (A.Length() == 0) && (A.Capacity() >= 4), "grow and shrink to empty");
+	check(max_moves <= max_moves_per_op, "O(1) moves while growing and shrinking");
+}
+
+void test3()
+{
+	// Copying and assigning in the middle of a resize gives an independent array
+	IncrementalCDA<Counted> A;
+	for (int i = 0; i < 1025; i++) A.AddEnd(Counted(i));
+	bool const b_resizing = A.Resizing();
+
+	IncrementalCDA<Counted> B(A);
+	IncrementalCDA<Counted> C;
+	C = A;
+	A[0] = Counted(-1);
+	A.AddFront(Counted(-2));
+
+	bool b_ok = b_resizing && (B.Length() == 1025) && (C.Length() == 1025);
+	for (int i = 0; b_ok && (i < 1025); i++) b_ok = (B[i].value == i) && (C[i].value == i);
+	check(b_ok && (A[0].value == -2) && (A[1].value == -1), "copy during a resize");
+}
+
+void test4()
+{
+	// Sort, Select and BinSearch in the middle of a resize, on ints and strings
+	IncrementalCDA<int> A;
+	deque<int> ref;
+	for (int i = 0; i < 1025; i++)
+	{
+		int const value = rand() % 300;
+		if (i % 2) { A.AddFront(value); ref.push_front(value); }
+		else { A.AddEnd(value); ref.push_back(value); }
+	}
+	bool const b_resizing = A.Resizing();
+
+	deque<int> sorted_ref(ref);
+	sort(sorted_ref.begin(), sorted_ref.end());
+	IncrementalCDA<int> S(A);
+	bool b_ok = b_resizing && (A.Select(500) == sorted_ref[499]) && (A.Length() == 1025);
+
+	S.Sort();
+	for (int i = 0; b_ok && (i < 1025); i++) b_ok = (S[i] == sorted_ref[i]);
+	for (int value = -1; value <= 300; value += 3)
+	{
+		int const lower = static_cast<int>(lower_bound(sorted_ref.begin(), sorted_ref.end(), value) - sorted_ref.begin());
+		bool const b_found = (lower < 1025) && (sorted_ref[lower] == value);
+		b_ok = b_ok && (S.BinSearch(value) == (b_found ? lower : ~lower));
+	}
+	check(b_ok, "sort, select and binary search during a resize");
+
+	IncrementalCDA<string> W;
+	deque<string> words;
+	for (int i = 0; i < 3000; i++) { W.AddFront(to_string(rand() % 1000)); words.push_front(W[0]); }
+	W.Sort();
+	sort(words.begin(), words.end());
+	b_ok = true;
+	for (int i = 0; b_ok && (i < 3000); i++) b_ok = (W[i] == words[i]);
+	check(b_ok, "string sort");
+}
+
+void test5()
+{
+	// The init constructor, and indexes checked by the error policy and by At()
+	IncrementalCDA<int, ThrowOnError> A(100, 7);
+	A.AddEnd(8);
+	bool b_ok = (A.Length() == 101) && (A[0] == 7) && (A[99] == 7) && (A[100] == 8);
+
+	int thrown = 0;
+	try { A[101]; } catch (out_of_range &) { thrown++; }
+	try { A[-1]; } catch (out_of_range &) { thrown++; }
+	try { A.Select(0); } catch (out_of_range &) { thrown++; }
+
+	IncrementalCDA<int, UncheckedAccess> B(3, 1);
+	try { B.At(3); } catch (out_of_range &) { thrown++; }
+	check(b_ok && (thrown == 4) && (B.At(2) == 1), "error policies");
+}
+
+int main()
+{
+	srand(12);
+	test1();
+	test2();
+	test3();
+	test4();
+	test5();
+	return report("IncrementalCDA");
+}
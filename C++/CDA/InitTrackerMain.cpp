@@ -0,0 +1,123 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Checks a tracker directly against a vector of flags, through random marks and unmarks
+template <typename tracker_type>
+void check_tracker(int capacity, const char * what)
+{
+	tracker_type tracker;
+	vector<bool> changed(capacity, false);
+	int count = 0;
+	bool b_ok = true;
+
+	// The memory of a new tracker may hold anything, so fill some first and free it
+	tracker.Create(capacity);
+	for (int i = 0; i < capacity; i += 3) tracker.Mark(i);
+	tracker.Free();
+	tracker.Create(capacity);
+
+	for (int op = 0; op < 4 * capacity; op++)
+	{
+		int const idx = rand() % capacity;
+		b_ok = b_ok && (tracker.WasChanged(idx) == changed[idx]);
+
+		if (changed[idx]) { tracker.Unmark(idx); count--; }
+		else { tracker.Mark(idx); count++; }
+		changed[idx] = !changed[idx];
+	}
+
+	tracker_type copy;
+	copy.Copy(tracker);
+	tracker_type taken;
+	taken.Take(tracker);
+
+	for (int idx = 0; idx < capacity; idx++)
+	{
+		b_ok = b_ok && (copy.WasChanged(idx) == changed[idx]) && (taken.WasChanged(idx) == changed[idx]);
+	}
+	b_ok = b_ok && (copy.Changed() == count) && (taken.Changed() == count) && (tracker.Changed() == 0);
+
+	copy.Free();
+	taken.Free();
+	check(b_ok, what);
+}
+
+// Runs random reads, writes, adds and deletes on an array initialized in constant time, checking it
+// against a deque
+template <typename tracker_type>
+void check_init_array(const char * what)
+{
+	CDA<string, GeneralCapacity, tracker_type> A(3000, "init");
+	deque<string> ref(3000, "init");
+	bool b_ok = true;
+
+	for (int op = 0; op < 20000; op++)
+	{
+		int const choice = rand() % 10;
+		string const value = "value " + to_string(op);
+
+		if (ref.empty() || (choice < 4))
+		{
+			if (!ref.empty())
+			{
+				int const idx = rand() % static_cast<int>(ref.size());
+				A[idx] = value;
+				ref[idx] = value;
+			}
+		}
+		else if (choice < 6)
+		{
+			int const idx = rand() % static_cast<int>(ref.size());
+			b_ok = b_ok && (A.Read(idx) == ref[idx]) && (A[idx] == ref[idx]);
+		}
+		else if (choice == 6) { A.AddEnd(value); ref.push_back(value); }
+		else if (choice == 7) { A.AddFront(value); ref.push_front(value); }
+		else if (choice == 8) { A.DelEnd(); ref.pop_back(); }
+		else { A.DelFront(); ref.pop_front(); }
+	}
+
+	b_ok = b_ok && (A.Length() == static_cast<int>(ref.size()));
+
+	// Copies and moves keep the init state
+	CDA<string, GeneralCapacity, tracker_type> B(A);
+	CDA<string, GeneralCapacity, tracker_type> C(move(A));
+	for (int idx = 0; b_ok && (idx < static_cast<int>(ref.size())); idx++)
+	{
+		b_ok = (B.Read(idx) == ref[idx]) && (C.Read(idx) == ref[idx]);
+	}
+	b_ok = b_ok && (C.Count("init") == B.Count("init"));
+	check(b_ok, what);
+}
+
+void test1()
+{
+	int const capacities[] = {1, 63, 64, 65, 4096, 4097, 100000};
+
+	for (int capacity : capacities)
+	{
+		check_tracker<SplitInitTracker>(capacity, "split tracker");
+		check_tracker<InterleavedInitTracker>(capacity, "interleaved tracker");
+		check_tracker<BitmapInitTracker>(capacity, "bitmap tracker");
+	}
+}
+
+void test2()
+{
+	check_init_array<SplitInitTracker>("split init array");
+	check_init_array<InterleavedInitTracker>("interleaved init array");
+	check_init_array<BitmapInitTracker>("bitmap init array");
+}
+
+int main()
+{
+	srand(17);
+	test1();
+	test2();
+	return report("InitTracker");
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// The input patterns, including ones that push quickselect towards quadratic time
+enum Pattern { RANDOM, ASCENDING, DESCENDING, EQUAL, ORGAN_PIPE, FEW_KEYS };
+
+int pattern_key(Pattern pattern, int i, int n)
+{
+	switch (pattern)
+	{
+		case RANDOM:     return rand();
+		case ASCENDING:  return i;
+		case DESCENDING: return n - i;
+		case EQUAL:      return 7;
+		case ORGAN_PIPE: return (i < n / 2) ? i : n - i;
+		default:         return rand() % 3;
+	}
+}
+
+// Checks that the rank k element is at index k - 1, with no larger element before it and no smaller
+// element after it
+bool partitioned_at(CDA<int> &A, int k, int expected)
+{
+	bool b_ok = (A[k - 1] == expected);
+	for (int i = 0; b_ok && (i < k - 1); i++) b_ok = !(A[k - 1] < A[i]);
+	for (int i = k; b_ok && (i < A.Length()); i++) b_ok = !(A[i] < A[k - 1]);
+	return b_ok;
+}
+
+void fill_pattern(CDA<int> &A, vector<int> &sorted, Pattern pattern, int n)
+{
+	for (int i = 0; i < n; i++)
+	{
+		int const key = pattern_key(pattern, i, n);
+		if (i % 3) A.AddEnd(key);
+		else A.AddFront(key);
+		sorted.push_back(key);
+	}
+	sort(sorted.begin(), sorted.end());
+}
+
+void test1()
+{
+	Pattern const patterns[] = {RANDOM, ASCENDING, DESCENDING, EQUAL, ORGAN_PIPE, FEW_KEYS};
+	int const sizes[] = {1, 2, 5, 16, 17, 100, 10000};
+
+	for (Pattern pattern : patterns)
+	{
+		for (int n : sizes)
+		{
+			for (int trial = 0; trial < 4; trial++)
+			{
+				CDA<int> A;
+				vector<int> sorted;
+				fill_pattern(A, sorted, pattern, n);
+
+				int const k = (trial == 0) ? 1 : (trial == 1) ? n : 1 + rand() % n;
+				check((A.Select(k) == sorted[k - 1]) && partitioned_at(A, k, sorted[k - 1]), "select");
+			}
+		}
+	}
+
+	// A large sorted input would take quadratic time without the introselect fallback
+	CDA<int> L;
+	vector<int> sorted;
+	fill_pattern(L, sorted, ASCENDING, 2000000);
+	check(L.Select(1000000) == sorted[999999], "large sorted select");
+}
+
+void test2()
+{
+	Pattern const patterns[] = {RANDOM, EQUAL, ORGAN_PIPE, FEW_KEYS};
+
+	for (Pattern pattern : patterns)
+	{
+		for (int trial = 0; trial < 20; trial++)
+		{
+			CDA<int> A;
+			vector<int> sorted;
+			int const n = 1 + rand() % 500;
+			fill_pattern(A, sorted, pattern, n);
+
+			// k1 == k2 is allowed, and selects a single rank
+			int k1 = 1 + rand() % n;
+			int k2 = (trial % 4 == 0) ? k1 : 1 + rand() % n;
+			if (k2 < k1) swap(k1, k2);
+
+			A.SelectRange(k1, k2);
+			check(partitioned_at(A, k1, sorted[k1 - 1]) && partitioned_at(A, k2, sorted[k2 - 1]), "select range");
+		}
+	}
+}
+
+void test3()
+{
+	// Bad ranks go through the error policy
+	CDA<int, GeneralCapacity, SplitInitTracker, ThrowOnError> A;
+	for (int i = 0; i < 10; i++) A.AddEnd(i);
+
+	int thrown = 0;
+	try { A.Select(0); } catch (out_of_range &) { thrown++; }
+	try { A.Select(11); } catch (out_of_range &) { thrown++; }
+	try { A.SelectRange(5, 4); } catch (out_of_range &) { thrown++; }
+	try { A.SelectRange(0, 4); } catch (out_of_range &) { thrown++; }
+	try { A.SelectRange(3, 11); } catch (out_of_range &) { thrown++; }
+	check(thrown == 5, "bad ranks throw");
+
+	// Init values are stored before selecting
+	CDA<char> E(100000, 'X');
+	E[49000] = 'A';
+	E[50000] = 'B';
+	check(E.Select(2) == 'B', "init array select");
+}
+
+int main()
+{
+	srand(7);
+	test1();
+	test2();
+	test3();
+	return report("IntroSelect");
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Builds a wrapped array and a deque holding the same n random values
+void fill_random(CDA<int> &A, deque<int> &ref, int n)
+{
+	for (int i = 0; i < n; i++) ref.push_back(rand() % 1000);
+	fill_wrapped(A, ref);
+}
+
+// Standard algorithms give the same results through the iterators as on a deque
+void test1()
+{
+	bool b_ok = true;
+
+	for (int n = 0; n <= 300; n += 7)
+	{
+		CDA<int> A;
+		deque<int> ref;
+		fill_random(A, ref, n);
+
+		b_ok = b_ok && (distance(A.begin(), A.end()) == n) && equal(A.begin(), A.end(), ref.begin());
+		b_ok = b_ok && equal(A.rbegin(), A.rend(), ref.rbegin());
+		b_ok = b_ok && (accumulate(A.cbegin(), A.cend(), 0L) == accumulate(ref.begin(), ref.end(), 0L));
+		b_ok = b_ok && (count(A.begin(), A.end(), 7) == count(ref.begin(), ref.end(), 7));
+
+		sort(A.begin(), A.end());
+		sort(ref.begin(), ref.end());
+		b_ok = b_ok && equal(A.begin(), A.end(), ref.begin());
+		b_ok = b_ok && ((lower_bound(A.begin(), A.end(), 500) - A.begin()) == (lower_bound(ref.begin(), ref.end(), 500) - ref.begin()));
+
+		reverse(A.begin(), A.end());
+		reverse(ref.begin(), ref.end());
+		b_ok = b_ok && equal(A.begin(), A.end(), ref.begin());
+	}
+	check(b_ok, "algorithms through the iterators");
+}
+
+// Iterator arithmetic and comparisons, mixing iterators and const_iterators
+void test2()
+{
+	CDA<int> A;
+	deque<int> ref;
+	fill_random(A, ref, 100);
+
+	CDA<int>::iterator it = A.begin();
+	CDA<int>::const_iterator cit = A.cbegin();
+	bool b_ok = (it == cit) && !(it != cit);
+
+	it += 10;
+	b_ok = b_ok && (*it == ref[10]) && (it[5] == ref[15]) && ((it - cit) == 10) && (cit < it) && (it > cit);
+	b_ok = b_ok && (*(it - 3) == ref[7]) && (*(2 + it) == ref[12]) && (*--it == ref[9]) && (*it++ == ref[9]);
+	b_ok = b_ok && (it <= A.end()) && (A.end() >= it) && ((A.end() - A.begin()) == 100);
+
+	*it = -5;
+	b_ok = b_ok && (A[10] == -5);
+	check(b_ok, "iterator arithmetic and comparisons");
+}
+
+// An iterator stays valid while elements are added at the back, through resizes
+void test3()
+{
+	CDA<int> A;
+	for (int i = 0; i < 4; i++) A.AddEnd(i);
+
+	CDA<int>::iterator it = A.begin() + 2;
+	for (int i = 4; i < 5000; i++) A.AddEnd(i);
+
+	check((*it == 2) && (it[100] == 102) && ((A.end() - it) == 4998), "iterators survive growth at the back");
+
+	// A const_iterator over an initialized array reads the init value without changing the array
+	const CDA<int> B(50, 9);
+	bool b_ok = (count(B.begin(), B.end(), 9) == 50);
+	CDA<int> C(50, 9);
+	C[3] = 1;
+	b_ok = b_ok && (count(C.cbegin(), C.cend(), 9) == 49) && (*min_element(C.begin(), C.end()) == 1);
+	check(b_ok, "iterators over initialized arrays");
+}
+
+int main()
+{
+	srand(20);
+	test1();
+	test2();
+	test3();
+	return report("Iterator");
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// An element compared only by its key, tagged with where it came from so stability can be checked
+struct Tagged
+{
+	int key;
+	int tag;
+
+	Tagged() : key(0), tag(0) {}
+	Tagged(int k, int t) : key(k), tag(t) {}
+	bool operator<(const Tagged &other) const { return key < other.key; }
+};
+
+// Merges k sorted inputs of random sizes, checking the result against a stable sort of everything
+bool check_merge(int k, int max_len, int range, int threads)
+{
+	vector<CDA<Tagged>> arrays(k);
+	vector<CDA<Tagged> *> inputs(k);
+	vector<Tagged> ref;
+
+	for (int input = 0; input < k; input++)
+	{
+		int const len = (max_len > 0) ? rand() % (max_len + 1) : 0;
+		vector<Tagged> v;
+		for (int i = 0; i < len; i++) v.push_back(Tagged(rand() % range, 0));
+		sort(v.begin(), v.end());
+		for (int i = 0; i < len; i++) v[i].tag = (input << 20) + i;
+
+		// Half of the inputs wrap around the end of their storage
+		if ((input % 2) == 0) for (const Tagged &e : v) arrays[input].AddEnd(e);
+		else fill_wrapped(arrays[input], v);
+
+		inputs[input] = &arrays[input];
+		ref.insert(ref.end(), v.begin(), v.end());
+	}
+
+	// The tags rise with the input and then the position, so a stable sort gives the expected order
+	stable_sort(ref.begin(), ref.end());
+
+	CDA<Tagged> merged = (threads == 1) ? CDA<Tagged>::MergeSorted(inputs.data(), k)
+	                                    : CDA<Tagged>::ParallelMergeSorted(inputs.data(), k, threads);
+
+	bool b_ok = (merged.Length() == static_cast<int>(ref.size()));
+	for (int i = 0; b_ok && (i < merged.Length()); i++)
+	{
+		b_ok = (merged[i].key == ref[i].key) && (merged[i].tag == ref[i].tag);
+	}
+	return b_ok;
+}
+
+// No inputs, one input, and many small inputs, with many ties
+void test1()
+{
+	bool b_ok = check_merge(0, 10, 5, 1) && check_merge(0, 10, 5, 4);
+
+	for (int trial = 0; trial < 20; trial++)
+	{
+		b_ok = b_ok && check_merge(1, 100, 10, 1) && check_merge(1, 100, 10, 4);
+		b_ok = b_ok && check_merge(2, 50, 5, 1) && check_merge(3, 50, 5, 1);
+		b_ok = b_ok && check_merge(17, 40, 8, 1) && check_merge(64, 10, 3, 1);
+		b_ok = b_ok && check_merge(5, 0, 1, 1);
+	}
+	check(b_ok, "small merges are sorted and stable");
+}
+
+// Merges large enough to be split between threads
+void test2()
+{
+	int const thread_counts[] = {1, 2, 3, 8};
+	bool b_ok = true;
+
+	for (int threads : thread_counts)
+	{
+		b_ok = b_ok && check_merge(2, 40000, 1000, threads);
+		b_ok = b_ok && check_merge(7, 20000, 50, threads);
+		b_ok = b_ok && check_merge(33, 3000, 1000000, threads);
+		b_ok = b_ok && check_merge(4, 30000, 1, threads);
+	}
+	check(b_ok, "parallel merges are sorted and stable");
+}
+
+// An input initialized in constant time is merged with its init values
+void test3()
+{
+	CDA<int> A(5000, 4);
+	A[10] = 4;
+	CDA<int> B;
+	for (int i = 0; i < 9; i++) B.AddEnd(i);
+	CDA<int> *inputs[] = {&A, &B};
+
+	CDA<int> merged = CDA<int>::MergeSorted(inputs, 2);
+	bool b_ok = (merged.Length() == 5009);
+	for (int i = 1; b_ok && (i < merged.Length()); i++) b_ok = !(merged[i] < merged[i - 1]);
+	b_ok = b_ok && (merged.Count(4) == 5001);
+	check(b_ok, "an initialized input");
+}
+
+int main()
+{
+	srand(25);
+	test1();
+	test2();
+	test3();
+	return report("KWayMerge");
+}
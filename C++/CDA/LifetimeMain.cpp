@@ -0,0 +1,149 @@
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <utility>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+long live     = 0;     // Constructions minus destructions of Tracked so far
+bool b_misuse = false; // Set if a dead element was used, or a live one constructed over
+
+int const alive_tag = 0x5eed;
+
+// An element that counts its instances, and notices being destroyed twice or used after destruction
+struct Tracked
+{
+	int value;
+	int tag;
+
+	Tracked() : value(0), tag(alive_tag) { live++; }
+	Tracked(int v) : value(v), tag(alive_tag) { live++; }
+	Tracked(const Tracked &other) : value(other.value), tag(alive_tag) { live++; use(other); }
+	Tracked(Tracked &&other) : value(other.value), tag(alive_tag) { live++; use(other); }
+	Tracked& operator=(const Tracked &other) { use(*this); use(other); value = other.value; return *this; }
+	Tracked& operator=(Tracked &&other) { use(*this); use(other); value = other.value; return *this; }
+	~Tracked() { use(*this); tag = 0; live--; }
+
+	bool operator<(const Tracked &other) const { use(*this); use(other); return value < other.value; }
+	bool operator==(const Tracked &other) const { use(*this); use(other); return value == other.value; }
+
+	static void use(const Tracked &t) { if (t.tag != alive_tag) b_misuse = true; }
+};
+
+// Every CDA holds two values of its own besides the elements, the init value and the reference value
+int const own_values = 2;
+
+// Adds, deletes, growth, shrinking and range drops keep exactly one live object per element
+void test1()
+{
+	long const live_before = live;
+	{
+		CDA<Tracked> A;
+		bool b_ok = true;
+
+		for (int i = 0; i < 3000; i++)
+		{
+			if (i % 2) A.AddEnd(Tracked(i));
+			else A.EmplaceFront(i);
+			b_ok = b_ok && (live - live_before == own_values + A.Length());
+		}
+		check(b_ok, "growing");
+
+		b_ok = true;
+		while (A.Length() > 1000)
+		{
+			if (A.Length() % 2) A.DelEnd();
+			else A.DelFront();
+			b_ok = b_ok && (live - live_before == own_values + A.Length());
+		}
+		check(b_ok, "shrinking");
+
+		A.DropFront(300);
+		A.DropBack(300);
+		A.ShrinkToFit();
+		A.Reserve(5000);
+		Tracked range[50];
+		A.AppendRange(range, 50);
+		A.PrependRange(&A[10], 20);
+		check(live - live_before == own_values + A.Length() + 50, "ranges, reserve and shrink to fit");
+
+		A.Sort();
+		A.Select(100);
+		A.InsertSorted(Tracked(5));
+		A.EraseSorted(Tracked(5));
+		A.EraseSorted(Tracked(-1));
+		check(live - live_before == own_values + A.Length() + 50, "sort, select and sorted inserts");
+
+		// Clearing the array
+		A.DropFront(A.Length());
+		check(live - live_before == own_values + 50, "clearing");
+	}
+	check(live == live_before, "destruction");
+}
+
+// Copies, moves and assignments of arrays
+void test2()
+{
+	long const live_before = live;
+	{
+		CDA<Tracked> A;
+		for (int i = 0; i < 100; i++) A.AddFront(i);
+
+		CDA<Tracked> B(A);
+		CDA<Tracked> C(move(B));
+		CDA<Tracked> D;
+		D.AddEnd(1);
+		D = A;
+		CDA<Tracked> E;
+		E.AddEnd(2);
+		E = move(D);
+		check(live - live_before == (5 * own_values) + 300, "copies and moves");
+	}
+	check(live == live_before, "destroying copies and moved-from arrays");
+}
+
+// The init constructor only constructs an element in its slot when it is changed or accessed for
+// writing, and reads don't construct anything
+void test3()
+{
+	long const live_before = live;
+	{
+		CDA<Tracked> A(10000, Tracked(7));
+		long const live_empty = live;
+		bool b_ok = (live_empty - live_before == own_values);
+
+		for (int i = 0; i < 10000; i += 100) b_ok = b_ok && (A.Read(i).value == 7);
+		b_ok = b_ok && (live == live_empty);
+
+		A[5] = Tracked(1);
+		A[9999].value = 2;
+		b_ok = b_ok && (live - live_empty == 2);
+		check(b_ok, "init values are only constructed when accessed for writing");
+
+		// Deleting, growing and copying with a mix of changed and unchanged slots
+		A.DelFront();
+		A.DelEnd();
+		for (int i = 0; i < 10000; i++) A.AddEnd(i);
+		CDA<Tracked> B(A);
+		A.DropFront(5000);
+		A.DropBack(100);
+		check(!b_misuse, "deleting and growing an initialized array");
+
+		// B holds the 10000 added elements and the one changed slot left. Sorting writes the init values
+		// out, so every element of A is then constructed
+		A.Sort();
+		check((live - live_before) == (2 * own_values) + A.Length() + 10001, "inserting the init values");
+	}
+	check((live == live_before) && !b_misuse, "destroying initialized arrays");
+}
+
+int main()
+{
+	srand(10);
+	test1();
+	test2();
+	test3();
+	check(!b_misuse, "no element used after it was destroyed");
+	return report("Lifetime");
+}
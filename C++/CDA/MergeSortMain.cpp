@@ -0,0 +1,168 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// A key with the order it was added in, to check that equal keys keep their order
+struct Tagged
+{
+	int key;
+	int seq;
+
+	bool operator<(const Tagged &other) const { return key < other.key; }
+	bool operator==(const Tagged &other) const { return (key == other.key) && (seq == other.seq); }
+};
+
+long copies = 0; // The number of element copies made so far
+
+// An element that counts every copy made of it, so a sort that should only move can be checked
+struct CopyCounted
+{
+	int key;
+
+	CopyCounted() : key(0) {}
+	CopyCounted(int k) : key(k) {}
+	CopyCounted(const CopyCounted &other) : key(other.key) { copies++; }
+	CopyCounted(CopyCounted &&other) : key(other.key) {}
+	CopyCounted& operator=(const CopyCounted &other) { key = other.key; copies++; return *this; }
+	CopyCounted& operator=(CopyCounted &&other) { key = other.key; return *this; }
+	bool operator<(const CopyCounted &other) const { return key < other.key; }
+};
+
+// An element that can only be moved
+struct MoveOnly
+{
+	unique_ptr<int> key;
+
+	bool operator<(const MoveOnly &other) const { return *key < *other.key; }
+};
+
+// The input patterns that take different paths through the sort
+enum Pattern { RANDOM, ASCENDING, DESCENDING, SAWTOOTH, EQUAL, FEW_KEYS };
+
+int pattern_key(Pattern pattern, int i, int n)
+{
+	switch (pattern)
+	{
+		case RANDOM:     return rand();
+		case ASCENDING:  return i;
+		case DESCENDING: return n - i;
+		case SAWTOOTH:   return i % 100;        // long ascending runs, so merges gallop
+		case EQUAL:      return 7;
+		default:         return rand() % 3;
+	}
+}
+
+// Sorts a CDA of tagged keys and compares against std::stable_sort
+void sort_pattern(Pattern pattern, int n, const char * what)
+{
+	CDA<Tagged> A;
+	vector<Tagged> values;
+
+	for (int i = 0; i < n; i++)
+	{
+		Tagged t = { pattern_key(pattern, i, n), i };
+		A.AddEnd(t);
+		values.push_back(t);
+	}
+
+	A.Sort();
+	stable_sort(values.begin(), values.end());
+
+	bool b_ok = true;
+	for (int i = 0; b_ok && (i < n); i++) b_ok = (A[i] == values[i]);
+	check(b_ok, what);
+}
+
+void test1()
+{
+	Pattern const patterns[] = {RANDOM, ASCENDING, DESCENDING, SAWTOOTH, EQUAL, FEW_KEYS};
+	int const sizes[] = {0, 1, 2, 31, 32, 33, 64, 65, 1000, 4097, 100000};
+
+	for (Pattern pattern : patterns)
+	{
+		for (int n : sizes) sort_pattern(pattern, n, "stable merge sort");
+	}
+}
+
+void test2()
+{
+	// The sorter on its own returns whichever buffer holds the result
+	for (int n = 1; n < 300; n += 7)
+	{
+		vector<int> data(n), scratch(n), expected(n);
+		for (int i = 0; i < n; i++) expected[i] = data[i] = rand() % 50;
+		sort(expected.begin(), expected.end());
+
+		int * sorted = BottomUpMergeSorter<int>::Sort(data.data(), scratch.data(), n);
+		bool b_ok = (sorted == data.data()) || (sorted == scratch.data());
+		for (int i = 0; b_ok && (i < n); i++) b_ok = (sorted[i] == expected[i]);
+		check(b_ok, "sorter result buffer");
+	}
+
+	// Strings sorted through the raw scratch storage, in a wrapped array
+	CDA<string> S;
+	vector<string> values;
+	for (int i = 0; i < 5000; i++)
+	{
+		string s = to_string(rand() % 1000);
+		if (i % 2) S.AddFront(s);
+		else S.AddEnd(s);
+	}
+	for (int i = 0; i < S.Length(); i++) values.push_back(S[i]);
+	S.Sort();
+	sort(values.begin(), values.end());
+	bool b_ok = true;
+	for (int i = 0; b_ok && (i < S.Length()); i++) b_ok = (S[i] == values[i]);
+	check(b_ok, "wrapped string sort");
+}
+
+void test3()
+{
+	Pattern const patterns[] = {RANDOM, DESCENDING, SAWTOOTH, FEW_KEYS};
+
+	// Every pass of the sort moves the elements, so none of them are copied
+	for (Pattern pattern : patterns)
+	{
+		CDA<CopyCounted> A;
+		for (int i = 0; i < 20000; i++)
+		{
+			if (i % 2) A.AddFront(pattern_key(pattern, i, 20000));
+			else A.AddEnd(pattern_key(pattern, i, 20000));
+		}
+
+		long const copies_before = copies;
+		A.Sort();
+
+		bool b_ok = (copies == copies_before);
+		for (int i = 1; b_ok && (i < A.Length()); i++) b_ok = !(A[i] < A[i - 1]);
+		check(b_ok, "the sort moves the elements without copying them");
+	}
+
+	// The sorter on its own sorts elements that can't be copied at all
+	for (int n = 0; n < 2000; n += 97)
+	{
+		vector<MoveOnly> data(n), scratch(n);
+		for (int i = 0; i < n; i++) data[i].key.reset(new int(rand() % 100));
+
+		MoveOnly * sorted = BottomUpMergeSorter<MoveOnly>::Sort(data.data(), scratch.data(), n);
+
+		bool b_ok = true;
+		for (int i = 0; b_ok && (i < n); i++) b_ok = sorted[i].key && ((i == 0) || !(sorted[i] < sorted[i - 1]));
+		check(b_ok, "move only elements");
+	}
+}
+
+int main()
+{
+	srand(6);
+	test1();
+	test2();
+	test3();
+	return report("MergeSort");
+}
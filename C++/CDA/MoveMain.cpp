@@ -0,0 +1,165 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+long copies = 0; // The number of element copies made so far
+long moves  = 0; // The number of element moves made so far
+
+// An element that counts every copy and move made of it
+struct Counted
+{
+	int value;
+
+	Counted() : value(0) {}
+	Counted(int v) : value(v) {}
+	Counted(int a, int b) : value(a + b) {}
+	Counted(const Counted &other) : value(other.value) { copies++; }
+	Counted(Counted &&other) : value(other.value) { moves++; }
+	Counted& operator=(const Counted &other) { value = other.value; copies++; return *this; }
+	Counted& operator=(Counted &&other) { value = other.value; moves++; return *this; }
+};
+
+// A moved-from array is empty with a capacity of 0, and can be used again
+void test1()
+{
+	deque<string> ref;
+	for (int i = 0; i < 100; i++) ref.push_back(to_string(i));
+
+	CDA<string> A;
+	fill_wrapped(A, ref);
+
+	CDA<string> B(move(A));
+	bool b_ok = (A.Length() == 0) && (A.Capacity() == 0) && same(B, ref);
+	A.AddEnd("end");
+	A.AddFront("front");
+	b_ok = b_ok && (A.Length() == 2) && (A[0] == "front") && (A[1] == "end");
+	check(b_ok, "move constructor");
+
+	CDA<string> C;
+	C.AddEnd("replaced");
+	C = move(B);
+	b_ok = (B.Length() == 0) && (B.Capacity() == 0) && same(C, ref);
+	B.AddFront("again");
+	check(b_ok && (B.Length() == 1) && (B[0] == "again"), "move assignment");
+
+	// Moving an array into itself leaves it as it was
+	CDA<string> &alias = C;
+	C = move(alias);
+	check(same(C, ref), "self move assignment");
+
+	// An array initialized in constant time keeps its init values when moved
+	CDA<string> D(50, "init");
+	D[3] = "three";
+	CDA<string> E(move(D));
+	check((E.Length() == 50) && (E[3] == "three") && (E[49] == "init") && (D.Length() == 0), "moving an initialized array");
+}
+
+// Adding by move and emplacing never copy, even when the array grows
+void test2()
+{
+	CDA<Counted> A;
+	long const copies_before = copies;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		if (i % 2) A.AddEnd(Counted(i));
+		else A.AddFront(Counted(i));
+	}
+	for (int i = 0; i < 1000; i++)
+	{
+		if (i % 2) A.EmplaceEnd(i, 1);
+		else A.EmplaceFront(i, 1);
+	}
+	check(copies == copies_before, "adds by move and emplaces make no copies");
+
+	// Emplacing into an array with room constructs the element in place
+	A.Reserve(A.Length() + 2);
+	long const moves_before = moves;
+	A.EmplaceEnd(7, 8);
+	A.EmplaceFront(1, 2);
+	check((moves == moves_before) && (A[0].value == 3) && (A[A.Length() - 1].value == 15), "emplace constructs in place");
+}
+
+// Emplacing onto a full array that wraps around the end of its storage, including from its own elements
+void test3()
+{
+	bool b_ok = true;
+
+	for (int n = 1; n <= 256; n *= 2)
+	{
+		CDA<string> A;
+		deque<string> ref;
+		for (int i = 0; i < n; i++) ref.push_back(to_string(i) + string(20, 'x'));
+		fill_wrapped(A, ref);
+		b_ok = b_ok && (A.Capacity() == A.Length());
+
+		A.EmplaceEnd(3, 'e');
+		ref.push_back(string(3, 'e'));
+		b_ok = b_ok && same(A, ref);
+
+		// Fill it up again, then emplace copies of its own front and back elements
+		while (A.Length() < A.Capacity()) { A.EmplaceFront(2, 'f'); ref.push_front(string(2, 'f')); }
+		A.EmplaceEnd(A[0]);
+		ref.push_back(ref[0]);
+		while (A.Length() < A.Capacity()) { A.EmplaceEnd(1, 'g'); ref.push_back(string(1, 'g')); }
+		A.EmplaceFront(A[A.Length() - 1]);
+		ref.push_front(ref[ref.size() - 1]);
+
+		b_ok = b_ok && same(A, ref);
+	}
+	check(b_ok, "emplace onto a wrapped full array");
+}
+
+// Elements that can only be moved go through adds, deletes, growth and Sort
+void test4()
+{
+	CDA<unique_ptr<int>> A;
+	long long sum = 0;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		int const value = rand() % 1000;
+		sum += value;
+
+		if (i % 3 == 0) A.AddEnd(unique_ptr<int>(new int(value)));
+		else if (i % 3 == 1) A.AddFront(unique_ptr<int>(new int(value)));
+		else A.EmplaceEnd(new int(value));
+	}
+
+	for (int i = 0; i < 500; i++)
+	{
+		sum -= *A[0] + *A[A.Length() - 1];
+		A.DelFront();
+		A.DelEnd();
+	}
+
+	A.Sort();
+
+	bool b_ok = (A.Length() == 1000);
+	long long found = 0;
+	for (int i = 0; b_ok && (i < A.Length()); i++)
+	{
+		b_ok = (A[i] != nullptr) && ((i == 0) || !(A[i] < A[i - 1]));
+		if (b_ok) found += *A[i];
+	}
+	check(b_ok && (found == sum), "move only elements");
+
+	CDA<unique_ptr<int>> B(move(A));
+	check((B.Length() == 1000) && (A.Length() == 0), "moving an array of move only elements");
+}
+
+int main()
+{
+	srand(9);
+	test1();
+	test2();
+	test3();
+	test4();
+	return report("Move");
+}
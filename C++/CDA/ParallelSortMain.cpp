@@ -0,0 +1,131 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// A key with the order it was added in, to check that equal keys keep their order
+struct Tagged
+{
+	int key;
+	int seq;
+
+	bool operator<(const Tagged &other) const { return key < other.key; }
+	bool operator==(const Tagged &other) const { return (key == other.key) && (seq == other.seq); }
+};
+
+long copies = 0; // The number of element copies made so far
+
+// An element that counts every copy made of it, so a sort that should only move can be checked
+struct CopyCounted
+{
+	int key;
+
+	CopyCounted() : key(0) {}
+	CopyCounted(int k) : key(k) {}
+	CopyCounted(const CopyCounted &other) : key(other.key) { copies++; }
+	CopyCounted(CopyCounted &&other) : key(other.key) {}
+	CopyCounted& operator=(const CopyCounted &other) { key = other.key; copies++; return *this; }
+	CopyCounted& operator=(CopyCounted &&other) { key = other.key; return *this; }
+	bool operator<(const CopyCounted &other) const { return key < other.key; }
+};
+
+// Sorts n tagged keys with each thread count and compares against std::stable_sort
+void sort_tagged(int n, int range, bool b_front, const char * what)
+{
+	int const thread_counts[] = {0, 1, 2, 3, 4, 8};
+
+	for (int threads : thread_counts)
+	{
+		CDA<Tagged> A;
+		vector<Tagged> values;
+
+		for (int i = 0; i < n; i++)
+		{
+			Tagged t = { rand() % range, i };
+			values.push_back(t);
+
+			// Adding to the front as well leaves the elements wrapped around the end
+			if (b_front && (i % 2)) A.AddFront(t);
+			else A.AddEnd(t);
+		}
+
+		values.clear();
+		for (int i = 0; i < A.Length(); i++) values.push_back(A[i]);
+
+		A.ParallelSort(threads);
+		stable_sort(values.begin(), values.end());
+
+		bool b_ok = (A.Length() == n);
+		for (int i = 0; b_ok && (i < n); i++) b_ok = (A[i] == values[i]);
+		check(b_ok, what);
+	}
+}
+
+void test1()
+{
+	for (int n = 0; n < 20; n++) sort_tagged(n, 4, true, "tiny sort");
+	sort_tagged(5000, 10, true, "wrapped stable sort");
+	sort_tagged(5000, 10, false, "contiguous stable sort");
+	sort_tagged(200000, 1000, true, "large wrapped sort");
+	sort_tagged(200001, 1000000, false, "large contiguous sort");
+}
+
+void test2()
+{
+	// A non-full array that starts part way into its storage is sorted where it is
+	CDA<int> A;
+	for (int i = 0; i < 1000; i++) A.AddEnd(1000 - i);
+	for (int i = 0; i < 300; i++) A.DelFront();
+	A.ParallelSort(4);
+	bool b_ok = (A.Length() == 700);
+	for (int i = 0; b_ok && (i < 700); i++) b_ok = (A[i] == i + 1);
+	A.AddFront(0); A.AddEnd(701);
+	check(b_ok && (A[0] == 0) && (A[701] == 701), "offset sort");
+
+	// Init values are stored before the threads start
+	CDA<string> S(3000, "m");
+	for (int i = 0; i < 3000; i += 7) S[i] = to_string(i % 10);
+	S.ParallelSort(3);
+	b_ok = true;
+	for (int i = 1; i < S.Length(); i++) b_ok = b_ok && !(S[i] < S[i - 1]);
+	check(b_ok && (S.Count("m") == 3000 - 429), "init string sort");
+}
+
+void test3()
+{
+	int const thread_counts[] = {1, 3, 8};
+
+	// The runs, the merges of every level and the run left without a partner all move the elements
+	for (int threads : thread_counts)
+	{
+		for (int b_wrapped = 0; b_wrapped < 2; b_wrapped++)
+		{
+			CDA<CopyCounted> A;
+			for (int i = 0; i < 100000; i++)
+			{
+				if (b_wrapped && (i % 2)) A.AddFront(rand());
+				else A.AddEnd(rand());
+			}
+
+			long const copies_before = copies;
+			A.ParallelSort(threads);
+
+			bool b_ok = (copies == copies_before);
+			for (int i = 1; b_ok && (i < A.Length()); i++) b_ok = !(A[i] < A[i - 1]);
+			check(b_ok, "the parallel sort moves the elements without copying them");
+		}
+	}
+}
+
+int main()
+{
+	srand(5);
+	test1();
+	test2();
+	test3();
+	return report("ParallelSort");
+}
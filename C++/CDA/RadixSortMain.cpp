@@ -0,0 +1,99 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Sorts with RadixSort and compares against std::sort, bit for bit for floating point values
+template <typename elmtype>
+void sort_and_compare(const vector<elmtype> &source, const char * what)
+{
+	CDA<elmtype> A;
+	vector<elmtype> values(source);
+	fill_wrapped(A, source);
+
+	A.RadixSort();
+	sort(values.begin(), values.end());
+
+	bool b_ok = (A.Length() == static_cast<int>(values.size()));
+	for (int i = 0; b_ok && (i < A.Length()); i++) b_ok = !(A[i] < values[i]) && !(values[i] < A[i]);
+
+	// Adding after the sort checks that the front and back were left consistent
+	A.AddEnd(source.empty() ? elmtype() : source[0]);
+	A.AddFront(source.empty() ? elmtype() : source[0]);
+	b_ok = b_ok && (A.Length() == static_cast<int>(values.size()) + 2);
+	check(b_ok, what);
+}
+
+template <typename elmtype>
+vector<elmtype> random_values(int n, long long lo, long long hi)
+{
+	vector<elmtype> values;
+	for (int i = 0; i < n; i++) values.push_back(static_cast<elmtype>(lo + (rand() % (hi - lo + 1))));
+	return values;
+}
+
+void test1()
+{
+	// Integral types, including negative values and the extremes
+	for (int n = 0; n < 40; n++) sort_and_compare(random_values<int>(n, -50, 50), "small int sort");
+	sort_and_compare(random_values<int>(100000, -1000000, 1000000), "int sort");
+	sort_and_compare(random_values<char>(5000, -128, 127), "char sort");
+	sort_and_compare(random_values<unsigned short>(5000, 0, 65535), "unsigned short sort");
+	sort_and_compare(random_values<unsigned>(50000, 0, 2000000000), "unsigned sort");
+
+	vector<long long> extremes = random_values<long long>(10000, -1000000, 1000000);
+	extremes.push_back(numeric_limits<long long>::min());
+	extremes.push_back(numeric_limits<long long>::max());
+	extremes.push_back(0);
+	sort_and_compare(extremes, "long long sort");
+}
+
+void test2()
+{
+	// Floating point types, with negative zero and infinities
+	vector<double> doubles;
+	for (int i = 0; i < 20000; i++) doubles.push_back((rand() - RAND_MAX / 2) / 1000.0);
+	doubles.push_back(-0.0);
+	doubles.push_back(0.0);
+	doubles.push_back(numeric_limits<double>::infinity());
+	doubles.push_back(-numeric_limits<double>::infinity());
+	doubles.push_back(numeric_limits<double>::denorm_min());
+	sort_and_compare(doubles, "double sort");
+
+	vector<float> floats;
+	for (int i = 0; i < 20000; i++) floats.push_back((rand() % 2001 - 1000) / 7.0f);
+	sort_and_compare(floats, "float sort");
+}
+
+void test3()
+{
+	// Sort() picks the radix sort for arithmetic types, and stores the init values first
+	CDA<int> D(1000, 5);
+	for (int i = 0; i < 1000; i += 3) D[i] = 1000 - i;
+	D.Sort();
+	bool b_ok = true;
+	for (int i = 1; i < D.Length(); i++) b_ok = b_ok && !(D[i] < D[i - 1]);
+	check(b_ok && (D.Count(5) == 666), "init array sort");
+
+	// A full array whose elements wrap around the end
+	CDA<int> F(8);
+	for (int i = 0; i < 8; i++) F[i] = 8 - i;
+	F.DelFront(); F.AddEnd(0);
+	F.Sort();
+	b_ok = true;
+	for (int i = 0; i < 8; i++) b_ok = b_ok && (F[i] == i);
+	check(b_ok, "full wrapped sort");
+}
+
+int main()
+{
+	srand(4);
+	test1();
+	test2();
+	test3();
+	return report("RadixSort");
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <string>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Returns true if the capacity is one the array could not shrink any further from, given the floor
+template <typename array_type>
+bool settled(array_type &A, int floor_capacity, int shrink_divisor)
+{
+	int const capacity = A.Capacity();
+	bool const b_could_halve = (A.Length() <= capacity / shrink_divisor) &&
+	                           ((capacity / 2) >= max(floor_capacity, A.Length()));
+	return (capacity >= A.Length()) && !b_could_halve;
+}
+
+// The default policy doubles a full array and halves it once it is 25% full
+void test1()
+{
+	CDA<int> A;
+	deque<int> ref;
+	bool b_ok = (A.Capacity() == 1);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		A.AddEnd(i);
+		ref.push_back(i);
+
+		int expected = 1;
+		while (expected < A.Length()) expected *= 2;
+		b_ok = b_ok && (A.Capacity() == expected);
+	}
+	check(b_ok, "the capacity doubles when the array is full");
+
+	b_ok = true;
+	while (A.Length() > 0)
+	{
+		A.DelFront();
+		ref.pop_front();
+		b_ok = b_ok && settled(A, 4, 4);
+	}
+	check(b_ok && (A.Capacity() == 4), "the capacity halves at 25% full, down to the minimum");
+
+	// Adding right after a shrink doesn't grow the array again
+	for (int i = 0; i < 64; i++) A.AddEnd(i);
+	while (A.Length() > 32) A.DelEnd();
+	int const capacity = A.Capacity();
+	A.AddEnd(1);
+	A.DelEnd();
+	A.AddEnd(1);
+	check(A.Capacity() == capacity, "no resize when adding and deleting around the boundary");
+}
+
+// Dropping many elements halves the array as many times as it needs to in one go
+void test2()
+{
+	CDA<string> A;
+	deque<string> ref;
+	for (int i = 0; i < 1024; i++) ref.push_back(to_string(i));
+	fill_wrapped(A, ref);
+	check(A.Capacity() == 1024, "full array");
+
+	A.DropBack(1021);
+	ref.erase(ref.begin() + 3, ref.end());
+	check((A.Capacity() == 8) && same(A, ref), "dropping to 3 elements leaves a capacity of 8");
+
+	A.DropFront(3);
+	check((A.Length() == 0) && (A.Capacity() == 4), "dropping everything leaves the minimum capacity");
+}
+
+// The floors set by the policy and by Reserve()
+void test3()
+{
+	ResizePolicy policy;
+	policy.min_capacity = 64;
+
+	CDA<int> A;
+	A.SetResizePolicy(policy);
+	for (int i = 0; i < 1000; i++) A.AddEnd(i);
+	while (A.Length() > 0) A.DelEnd();
+	check(A.Capacity() == 64, "the minimum capacity of the policy");
+
+	CDA<int> B;
+	B.Reserve(500);
+	bool b_ok = (B.Capacity() == 500);
+	for (int i = 0; i < 500; i++) B.AddEnd(i);
+	b_ok = b_ok && (B.Capacity() == 500);
+	while (B.Length() > 0) B.DelFront();
+	check(b_ok && (B.Capacity() == 500), "reserved capacity is kept until ShrinkToFit");
+
+	B.ShrinkToFit();
+	check(B.Capacity() == 1, "ShrinkToFit on an empty array");
+	for (int i = 0; i < 100; i++) B.AddEnd(i);
+	while (B.Length() > 0) B.DelFront();
+	check(B.Capacity() == 4, "ShrinkToFit clears the reserved capacity");
+
+	// Reserving less than the size doesn't shrink the array, and becomes the floor
+	CDA<int> C;
+	deque<int> ref;
+	for (int i = 0; i < 100; i++) { C.AddEnd(i); ref.push_back(i); }
+	C.Reserve(10);
+	b_ok = (C.Capacity() == 128) && same(C, ref);
+	while (C.Length() > 0) C.DelEnd();
+	check(b_ok && (C.Capacity() == 16), "reserving less than the size");
+
+	// Shrinking can be turned off, and the divisor is never below 2
+	policy = ResizePolicy();
+	policy.b_shrink = false;
+	CDA<int> D;
+	D.SetResizePolicy(policy);
+	for (int i = 0; i < 300; i++) D.AddEnd(i);
+	while (D.Length() > 0) D.DelEnd();
+	check(D.Capacity() == 512, "no shrinking");
+
+	policy = ResizePolicy();
+	policy.shrink_divisor = 1;
+	CDA<int> E;
+	E.SetResizePolicy(policy);
+	for (int i = 0; i < 256; i++) E.AddEnd(i);
+	b_ok = true;
+	while (E.Length() > 0)
+	{
+		E.DelEnd();
+		b_ok = b_ok && settled(E, 4, 2);
+	}
+	check(b_ok, "a divisor below 2 acts as 2");
+}
+
+// A growth factor other than 2, and ShrinkToFit on a wrapped array
+void test4()
+{
+	ResizePolicy policy;
+	policy.growth_factor = 1.5;
+
+	CDA<int> A;
+	A.SetResizePolicy(policy);
+	bool b_ok = true;
+	int last_capacity = A.Capacity();
+	for (int i = 0; i < 10000; i++)
+	{
+		A.AddEnd(i);
+		if (A.Capacity() != last_capacity)
+		{
+			b_ok = b_ok && (A.Capacity() == max(last_capacity + 1, static_cast<int>(last_capacity * 1.5)));
+			last_capacity = A.Capacity();
+		}
+	}
+	check(b_ok, "the capacity grows by the growth factor");
+
+	CDA<string> B;
+	deque<string> ref;
+	for (int i = 0; i < 300; i++) ref.push_back(to_string(i));
+	fill_wrapped(B, ref);
+	B.DelEnd();
+	ref.pop_back();
+	B.ShrinkToFit();
+	b_ok = (B.Capacity() == 299) && same(B, ref);
+
+	B.AddFront("front");
+	ref.push_front("front");
+	B.AddEnd("back");
+	ref.push_back("back");
+	check(b_ok && same(B, ref), "ShrinkToFit on a wrapped array");
+}
+
+int main()
+{
+	srand(13);
+	test1();
+	test2();
+	test3();
+	test4();
+	return report("Resize");
+}
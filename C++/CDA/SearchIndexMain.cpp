@@ -0,0 +1,115 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "../SearchIndex.cpp"
+#include "Check.cpp"
+
+// Returns a sorted vector of n values drawn from [0, range), so a small range gives many duplicates
+vector<int> sorted_values(int n, int range)
+{
+	vector<int> v(n);
+	for (int i = 0; i < n; i++) v[i] = rand() % range;
+	sort(v.begin(), v.end());
+	return v;
+}
+
+// Branchless bounds match std::lower_bound and std::upper_bound for every size up to 300, with keys
+// below, between, on and above the values
+void test1()
+{
+	bool b_ok = true;
+
+	for (int n = 0; n <= 300; n++)
+	{
+		vector<int> v = sorted_values(n, 1 + n / 4);
+		auto get = [&v](int idx) -> const int & { return v[idx]; };
+
+		for (int key = -1; key <= 2 + n / 4; key++)
+		{
+			int const lower = lower_bound(v.begin(), v.end(), key) - v.begin();
+			int const upper = upper_bound(v.begin(), v.end(), key) - v.begin();
+
+			b_ok = b_ok && (BranchlessBound<false>(get, n, key) == lower);
+			b_ok = b_ok && (BranchlessBound<true>(get, n, key) == upper);
+		}
+	}
+	check(b_ok, "branchless bounds match the standard bounds");
+}
+
+// The Eytzinger index gives the same bounds, including across rebuilds of the same object
+void test2()
+{
+	bool b_ok = true;
+	EytzingerIndex<int> index;
+
+	for (int n = 0; n <= 300; n++)
+	{
+		vector<int> v = sorted_values(n, 1 + n / 3);
+		EytzingerIndex<int> fresh(v.begin(), v.end());
+		index.Build(v.begin(), v.end());
+
+		b_ok = b_ok && (fresh.Length() == n) && (index.Length() == n);
+
+		for (int key = -1; key <= 2 + n / 3; key++)
+		{
+			int const lower = lower_bound(v.begin(), v.end(), key) - v.begin();
+			int const upper = upper_bound(v.begin(), v.end(), key) - v.begin();
+
+			b_ok = b_ok && (index.LowerBound(key) == lower) && (index.UpperBound(key) == upper);
+			b_ok = b_ok && (fresh.EqualRange(key) == make_pair(lower, upper));
+		}
+	}
+	check(b_ok, "Eytzinger bounds match the standard bounds");
+
+	// A large index with strings, searched for values that are and aren't present
+	vector<string> words;
+	for (int i = 0; i < 100000; i++) words.push_back(to_string(rand() % 50000));
+	sort(words.begin(), words.end());
+	EytzingerIndex<string> word_index(words.begin(), words.end());
+
+	b_ok = true;
+	for (int i = 0; i < 20000; i++)
+	{
+		string const key = to_string(rand() % 60000);
+		b_ok = b_ok && (word_index.LowerBound(key) == lower_bound(words.begin(), words.end(), key) - words.begin());
+		b_ok = b_ok && (word_index.UpperBound(key) == upper_bound(words.begin(), words.end(), key) - words.begin());
+	}
+	check(b_ok, "Eytzinger bounds on a large string index");
+}
+
+// The bounds of a sorted CDA match, whether or not the array wraps around the end of its storage
+void test3()
+{
+	bool b_ok = true;
+
+	for (int n = 0; n <= 200; n++)
+	{
+		vector<int> v = sorted_values(n, 1 + n / 4);
+		CDA<int> A;
+
+		fill_wrapped(A, v);
+
+		for (int key = -1; key <= 2 + n / 4; key++)
+		{
+			int const lower = lower_bound(v.begin(), v.end(), key) - v.begin();
+			int const upper = upper_bound(v.begin(), v.end(), key) - v.begin();
+
+			b_ok = b_ok && (A.LowerBound(key) == lower) && (A.UpperBound(key) == upper);
+			b_ok = b_ok && (A.EqualRange(key) == make_pair(lower, upper));
+		}
+	}
+	check(b_ok, "bounds of a wrapped CDA match the standard bounds");
+}
+
+int main()
+{
+	srand(21);
+	test1();
+	test2();
+	test3();
+	return report("SearchIndex");
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <string>
+using namespace std;
+#include "../SegmentedCDA.cpp"
+#include "Check.cpp"
+
+long copies = 0; // The number of element copies made so far
+long moves  = 0; // The number of element moves made so far
+
+// An element that counts every copy and move made of it
+struct Counted
+{
+	int key;
+
+	Counted() : key(0) {}
+	Counted(int k) : key(k) {}
+	Counted(const Counted &other) : key(other.key) { copies++; }
+	Counted(Counted &&other) : key(other.key) { moves++; }
+	Counted& operator=(const Counted &other) { key = other.key; copies++; return *this; }
+	Counted& operator=(Counted &&other) { key = other.key; moves++; return *this; }
+	bool operator<(const Counted &other) const { return key < other.key; }
+};
+
+void test1()
+{
+	// Random adds and deletes at both ends, in phases that grow and then shrink the array
+	SegmentedCDA<int, 3> A;
+	deque<int> ref;
+	bool b_ok = true;
+
+	for (int phase = 0; phase < 6; phase++)
+	{
+		int const add_chance = (phase % 2 == 0) ? 75 : 25;
+
+		for (int op = 0; op < 20000; op++)
+		{
+			int const value = rand();
+
+			if (ref.empty() || ((rand() % 100) < add_chance))
+			{
+				if (rand() % 2) { A.AddEnd(value); ref.push_back(value); }
+				else { A.AddFront(value); ref.push_front(value); }
+			}
+			else
+			{
+				if (rand() % 2) { A.DelEnd(); ref.pop_back(); }
+				else { A.DelFront(); ref.pop_front(); }
+			}
+
+			if (op % 1000 == 0) b_ok = b_ok && same(A, ref);
+		}
+	}
+	check(b_ok && same(A, ref), "random deque operations");
+	check(A.Capacity() >= A.Length(), "capacity");
+}
+
+void test2()
+{
+	// Growing never moves the existing elements
+	SegmentedCDA<string, 2> A;
+	for (int i = 0; i < 10; i++) A.AddEnd(to_string(i));
+	string * first = &A[0];
+	string * last = &A[9];
+	for (int i = 0; i < 5000; i++) { A.AddEnd("e"); A.AddFront("f"); }
+	check((&A[5000] == first) && (&A[5009] == last) && (*first == "0"), "elements never move");
+
+	// The init constructor only fills blocks as they are used
+	SegmentedCDA<int, 4> D(100000, -10);
+	D[5] = 5;
+	D[99999] = 7;
+	check((D[5] == 5) && (D[6] == -10) && (D[50000] == -10) && (D[99999] == 7), "init values");
+	check((D.Search(7) == 99999) && (D.Count(-10) == 99998), "init search and count");
+
+	// Copies are deep, and assignment replaces the contents
+	SegmentedCDA<int, 4> C(D);
+	C[6] = 1;
+	SegmentedCDA<int, 4> B;
+	B = C;
+	C[7] = 2;
+	check((D[6] == -10) && (B[6] == 1) && (B[7] == -10) && (C[7] == 2), "copies are deep");
+}
+
+void test3()
+{
+	// Sort, Select, Search and BinSearch across block boundaries
+	SegmentedCDA<int, 3> A;
+	deque<int> ref;
+	for (int i = 0; i < 5000; i++)
+	{
+		int const value = rand() % 2000;
+		if (i % 2) { A.AddEnd(value); ref.push_back(value); }
+		else { A.AddFront(value); ref.push_front(value); }
+	}
+
+	int const wanted = ref[1234];
+	check(A.Search(wanted) == static_cast<int>(find(ref.begin(), ref.end(), wanted) - ref.begin()), "search");
+	check(A.Count(wanted) == static_cast<int>(count(ref.begin(), ref.end(), wanted)), "count");
+
+	SegmentedCDA<int, 3> S(A);
+	sort(ref.begin(), ref.end());
+	check(S.Select(2500) == ref[2499], "select");
+
+	A.Sort();
+	check(same(A, ref), "sort");
+
+	bool b_ok = true;
+	for (int value = -1; value <= 2000; value += 7)
+	{
+		int const lower = static_cast<int>(lower_bound(ref.begin(), ref.end(), value) - ref.begin());
+		bool const b_found = (lower < static_cast<int>(ref.size())) && (ref[lower] == value);
+		b_ok = b_ok && (A.BinSearch(value) == (b_found ? lower : ~lower));
+	}
+	check(b_ok, "binary search");
+
+	int thrown = 0;
+	try { A.At(5000); } catch (out_of_range &) { thrown++; }
+	try { A.At(-1); } catch (out_of_range &) { thrown++; }
+	check((thrown == 2) && (A.At(0) == ref[0]), "checked access");
+}
+
+void test4()
+{
+	// Sorting moves each element out of the blocks and back once, and only moves it in between
+	SegmentedCDA<Counted, 3> A;
+	for (int i = 0; i < 10000; i++) A.AddEnd(i);
+
+	long const copies_before = copies;
+	long const moves_before  = moves;
+	A.Sort();
+	check((copies == copies_before) && (moves - moves_before == 2 * 10000), "sorting a sorted array moves each element twice");
+
+	SegmentedCDA<Counted, 3> B;
+	for (int i = 0; i < 10000; i++)
+	{
+		if (i % 2) B.AddFront(rand() % 100);
+		else B.AddEnd(rand() % 100);
+	}
+	B.Sort();
+	bool b_ok = (copies == copies_before);
+	for (int i = 1; b_ok && (i < B.Length()); i++) b_ok = !(B[i] < B[i - 1]);
+	check(b_ok, "sorting moves the elements without copying them");
+}
+
+int main()
+{
+	srand(11);
+	test1();
+	test2();
+	test3();
+	test4();
+	return report("SegmentedCDA");
+}
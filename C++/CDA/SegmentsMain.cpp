@@ -0,0 +1,137 @@
+#include <iostream>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Collects the segments passed to it, checking each one starts where the last one stopped
+struct SegmentCollector
+{
+	vector<int> * p_values;
+	int * p_next;
+	int * p_calls;
+	bool * p_ok;
+
+	void operator()(int * seg, int seg_len, int start)
+	{
+		*p_ok = *p_ok && (seg_len > 0) && (start == *p_next);
+		for (int i = 0; i < seg_len; i++) p_values->push_back(seg[i]);
+		*p_next = start + seg_len;
+		(*p_calls)++;
+	}
+};
+
+// Checks Segments() and ForEachSegment() against operator[] order
+bool same_segments(CDA<int> &A, int expected_segments)
+{
+	int * first;
+	int * second;
+	int first_len;
+	int second_len;
+	int const count = A.Segments(first, first_len, second, second_len);
+
+	bool b_ok = (count == expected_segments) && (first_len + second_len == A.Length());
+	b_ok = b_ok && (count == (first_len > 0) + (second_len > 0)) && ((second_len == 0) || (first_len > 0));
+	for (int i = 0; b_ok && (i < first_len); i++) b_ok = (&first[i] == &A[i]);
+	for (int i = 0; b_ok && (i < second_len); i++) b_ok = (&second[i] == &A[first_len + i]);
+
+	vector<int> values;
+	int next = 0;
+	int calls = 0;
+	SegmentCollector collect = { &values, &next, &calls, &b_ok };
+	A.ForEachSegment(collect);
+
+	b_ok = b_ok && (calls == count) && (static_cast<int>(values.size()) == A.Length());
+	for (int i = 0; b_ok && (i < A.Length()); i++) b_ok = (values[i] == A[i]);
+	return b_ok;
+}
+
+// Checks ForEachSegment() over the range [from, to) against operator[] order
+bool same_range(CDA<int> &A, int from, int to)
+{
+	vector<int> values;
+	int next = from;
+	int calls = 0;
+	bool b_ok = true;
+	SegmentCollector collect = { &values, &next, &calls, &b_ok };
+	A.ForEachSegment(A.begin() + from, A.begin() + to, collect);
+
+	b_ok = b_ok && (calls <= 2) && (static_cast<int>(values.size()) == to - from);
+	for (int i = 0; b_ok && (i < to - from); i++) b_ok = (values[i] == A[from + i]);
+	return b_ok;
+}
+
+void test1()
+{
+	// Empty arrays, before and after elements were added
+	CDA<int> A;
+	CDA<int> B(100);
+	bool b_ok = same_segments(A, 0);
+	for (int i = 0; i < 10; i++) B.AddFront(i);
+	B.DropBack(B.Length());
+	check(b_ok && same_segments(B, 0) && same_range(B, 0, 0), "empty arrays have no segments");
+
+	// A contiguous array, starting at the start of the storage and part way into it
+	CDA<int> C;
+	for (int i = 0; i < 100; i++) C.AddEnd(i);
+	b_ok = same_segments(C, 1);
+	for (int i = 0; i < 30; i++) C.DelFront();
+	check(b_ok && same_segments(C, 1), "a contiguous array is one segment");
+
+	// A wrapped array, full and not full
+	CDA<int> D;
+	fill_wrapped(D, deque<int>(64, 0));
+	for (int i = 0; i < 64; i++) D[i] = i;
+	b_ok = same_segments(D, 2) && (D.Capacity() == 64);
+	D.DelEnd();
+	check(b_ok && same_segments(D, 2), "a wrapped array is two segments");
+
+	// The init values are stored before the segments are returned
+	CDA<int> E(1000, 3);
+	E[500] = 4;
+	check(same_segments(E, 1) && (E[499] == 3) && (E[500] == 4), "init values are in the segments");
+}
+
+void test2()
+{
+	// Random arrays and random ranges, with each range start and end in either segment
+	bool b_ok = true;
+
+	for (int round = 0; round < 200; round++)
+	{
+		CDA<int> A;
+		int const n = rand() % 300;
+		for (int i = 0; i < n; i++)
+		{
+			if (rand() % 2) A.AddFront(rand());
+			else A.AddEnd(rand());
+		}
+
+		int * first;
+		int * second;
+		int first_len;
+		int second_len;
+		int const count = A.Segments(first, first_len, second, second_len);
+		b_ok = b_ok && same_segments(A, count);
+
+		for (int r = 0; b_ok && (r < 20); r++)
+		{
+			int from = rand() % (n + 1);
+			int to = rand() % (n + 1);
+			if (from > to) swap(from, to);
+			b_ok = same_range(A, from, to);
+		}
+		b_ok = b_ok && same_range(A, 0, n) && same_range(A, first_len, n) && same_range(A, 0, first_len);
+	}
+	check(b_ok, "ranges of random arrays");
+}
+
+int main()
+{
+	srand(2);
+	test1();
+	test2();
+	return report("Segments");
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Selects a set of ranks at once and checks each result and the partition around it
+void select_ranks(int n, int range, const vector<int> &ranks, const char * what)
+{
+	CDA<int> A;
+	vector<int> sorted;
+
+	for (int i = 0; i < n; i++)
+	{
+		int const key = rand() % range;
+		if (i % 2) A.AddEnd(key);
+		else A.AddFront(key);
+		sorted.push_back(key);
+	}
+	sort(sorted.begin(), sorted.end());
+
+	vector<int> out(ranks.size());
+	A.SelectMany(ranks.data(), static_cast<int>(ranks.size()), out.data());
+
+	bool b_ok = true;
+	for (size_t r = 0; b_ok && (r < ranks.size()); r++)
+	{
+		int const k = ranks[r];
+		b_ok = (out[r] == sorted[k - 1]) && (A[k - 1] == sorted[k - 1]);
+		for (int i = 0; b_ok && (i < k - 1); i++) b_ok = !(A[k - 1] < A[i]);
+		for (int i = k; b_ok && (i < n); i++) b_ok = !(A[i] < A[k - 1]);
+	}
+	check(b_ok, what);
+}
+
+void test1()
+{
+	for (int trial = 0; trial < 30; trial++)
+	{
+		int const n = 1 + rand() % 3000;
+		vector<int> ranks;
+		int const m = 1 + rand() % 20;
+
+		// Unsorted ranks with repeats, including both ends
+		for (int r = 0; r < m; r++) ranks.push_back(1 + rand() % n);
+		ranks.push_back(1);
+		ranks.push_back(n);
+		ranks.push_back(ranks[0]);
+
+		select_ranks(n, (trial % 2) ? 5 : 1000000, ranks, "select many");
+	}
+
+	// Percentiles of a large array
+	vector<int> percentiles;
+	for (int p = 1; p <= 99; p++) percentiles.push_back(p * 10000);
+	select_ranks(1000000, 1000000, percentiles, "percentiles");
+}
+
+void test2()
+{
+	// A bad rank leaves the array and the output alone
+	CDA<int, GeneralCapacity, SplitInitTracker, ThrowOnError> A;
+	for (int i = 0; i < 10; i++) A.AddEnd(9 - i);
+
+	int const ranks[] = {2, 11};
+	int out[2] = {-1, -1};
+	bool b_thrown = false;
+	try { A.SelectMany(ranks, 2, out); } catch (out_of_range &) { b_thrown = true; }
+	check(b_thrown && (out[0] == -1) && (A[0] == 9), "bad rank throws");
+
+	// No ranks is a no-op
+	A.SelectMany(ranks, 0, out);
+	check(A[0] == 9, "no ranks");
+}
+
+int main()
+{
+	srand(8);
+	test1();
+	test2();
+	return report("SelectMany");
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <cstdlib>
+#include <string>
+using namespace std;
+#include "../CDA.cpp"
+#include "Check.cpp"
+
+// Scalar reference for Search, Count and FindAll
+template <typename elmtype>
+bool matches_reference(CDA<elmtype> &A, elmtype e)
+{
+	int first = -1;
+	int count = 0;
+	CDA<int> found(0);
+	CDA<int> expected(0);
+
+	for (int i = 0; i < A.Length(); i++)
+	{
+		if (A[i] == e)
+		{
+			if (first < 0) first = i;
+			count++;
+			expected.AddEnd(i);
+		}
+	}
+
+	A.FindAll(e, found);
+
+	bool b_ok = (A.Search(e) == first) && (A.Count(e) == count) && (found.Length() == count);
+	for (int i = 0; b_ok && (i < count); i++) b_ok = (found[i] == expected[i]);
+
+	return b_ok;
+}
+
+// Fills an array from both ends so it wraps around, then scans for every value
+template <typename elmtype>
+void scan_wrapped(const char * what, int n, int range)
+{
+	CDA<elmtype> A;
+	for (int i = 0; i < n; i++)
+	{
+		if (i % 2) A.AddEnd(static_cast<elmtype>(rand() % range));
+		else A.AddFront(static_cast<elmtype>(rand() % range));
+	}
+
+	bool b_ok = true;
+	for (int v = -1; v <= range; v++) b_ok = b_ok && matches_reference(A, static_cast<elmtype>(v));
+	check(b_ok, what);
+}
+
+void test1()
+{
+	// Every length around the vector widths, so each tail case is covered
+	for (int n = 0; n < 70; n++)
+	{
+		scan_wrapped<char>("char scan", n, 5);
+		scan_wrapped<short>("short scan", n, 5);
+		scan_wrapped<int>("int scan", n, 5);
+		scan_wrapped<long>("long scan", n, 5);
+		scan_wrapped<float>("float scan", n, 5);
+		scan_wrapped<double>("double scan", n, 5);
+	}
+	scan_wrapped<int>("large int scan", 100000, 1000);
+	scan_wrapped<unsigned char>("large unsigned char scan", 100000, 200);
+}
+
+void test2()
+{
+	// Arrays initialized in constant time and non-arithmetic types use the scalar path
+	CDA<int> D(1000, 7);
+	D[10] = 3; D[999] = 3;
+	check(matches_reference(D, 7) && matches_reference(D, 3) && matches_reference(D, 4), "init array scan");
+
+	CDA<string> S;
+	for (int i = 0; i < 500; i++) S.AddFront(to_string(i % 13));
+	check(matches_reference(S, string("5")) && matches_reference(S, string("x")), "string scan");
+
+	// NaN never compares equal
+	CDA<double> N;
+	N.AddEnd(0.0 / 0.0); N.AddEnd(1.0);
+	check((N.Search(0.0 / 0.0) == -1) && (N.Count(1.0) == 1), "NaN scan");
+}
+
+int main()
+{
+	srand(3);
+	test1();
+	test2();
+	return report("SimdScan");
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "../TieredCDA.cpp"
+#include "Check.cpp"
+
+long moves = 0; // The number of element copies and moves made so far
+
+// An element that counts every copy and move made of it
+struct Counted
+{
+	int value;
+
+	Counted() : value(0) {}
+	Counted(int v) : value(v) {}
+	Counted(const Counted &other) : value(other.value) { moves++; }
+	Counted(Counted &&other) : value(other.value) { moves++; }
+	Counted& operator=(const Counted &other) { value = other.value; moves++; return *this; }
+	Counted& operator=(Counted &&other) { value = other.value; moves++; return *this; }
+	bool operator<(const Counted &other) const { return value < other.value; }
+};
+
+// The few copies of the element being inserted or erased, on top of the elements shifted over
+const long extra_moves = 8;
+
+// A TieredCDA moves at most one tier's worth of elements plus one element per tier. Each tier also
+// holds two spare elements of its own, which are moved with it when the directory of tiers grows.
+long tiered_max_moves(int tier_size, int n)
+{
+	return tier_size + (3 * (n / tier_size + 1)) + extra_moves;
+}
+
+// Inserts into and erases from a sorted CDA, checking it against a sorted vector, and that each
+// operation moves at most half of the elements
+void test1()
+{
+	CDA<Counted> A;
+	vector<int>  ref;
+	bool b_ok = true;
+	bool b_moves_ok = true;
+
+	for (int op = 0; op < 40000; op++)
+	{
+		int const value = rand() % 5000;
+		int const half  = static_cast<int>(ref.size()) / 2;
+		int const capacity = A.Capacity();
+		long const moves_before = moves;
+
+		if ((rand() % 3) != 0)
+		{
+			int const idx = A.InsertSorted(value);
+			int const ref_idx = upper_bound(ref.begin(), ref.end(), value) - ref.begin();
+			ref.insert(ref.begin() + ref_idx, value);
+			b_ok = b_ok && (idx == ref_idx);
+		}
+		else
+		{
+			auto const it = lower_bound(ref.begin(), ref.end(), value);
+			bool const b_found = (it != ref.end()) && (*it == value);
+			if (b_found) ref.erase(it);
+			b_ok = b_ok && (A.EraseSorted(value) == b_found);
+		}
+
+		// A resize moves every element, so only the operations that don't resize are bounded
+		if (A.Capacity() != capacity) continue;
+		b_moves_ok = b_moves_ok && ((moves - moves_before) <= half + extra_moves);
+	}
+
+	b_ok = b_ok && (A.Length() == static_cast<int>(ref.size()));
+	for (int i = 0; b_ok && (i < A.Length()); i++) b_ok = (A[i].value == ref[i]);
+	check(b_ok, "CDA stays sorted");
+	check(b_moves_ok, "CDA moves at most half of the elements");
+}
+
+// Grows a TieredCDA to 30000 elements and shrinks it back, checking it against a sorted vector and
+// that each operation that doesn't change the tier size moves O(sqrt(N)) elements
+void test2()
+{
+	TieredCDA<Counted> T;
+	vector<int> ref;
+	bool b_ok = true;
+	bool b_moves_ok = true;
+	long max_moves = 0;
+
+	for (int phase = 0; phase < 2; phase++)
+	{
+		// Mostly inserts while growing, and mostly erases of elements that are there while shrinking
+		int const insert_chance = (phase == 0) ? 3 : 1;
+
+		for (int op = 0; op < 60000; op++)
+		{
+			int value = rand() % 50000;
+			if ((phase == 1) && !ref.empty()) value = ref[rand() % ref.size()];
+			int const tier_size = T.TierSize();
+			long const moves_before = moves;
+
+			if ((rand() % 4) < insert_chance)
+			{
+				int const idx = T.InsertSorted(value);
+				int const ref_idx = upper_bound(ref.begin(), ref.end(), value) - ref.begin();
+				ref.insert(ref.begin() + ref_idx, value);
+				b_ok = b_ok && (idx == ref_idx);
+			}
+			else
+			{
+				auto const it = lower_bound(ref.begin(), ref.end(), value);
+				bool const b_found = (it != ref.end()) && (*it == value);
+				if (b_found) ref.erase(it);
+				b_ok = b_ok && (T.EraseSorted(value) == b_found);
+			}
+
+			int const n = static_cast<int>(ref.size());
+			b_ok = b_ok && (T.Length() == n);
+
+			if (T.TierSize() == tier_size)
+			{
+				long const op_moves = moves - moves_before;
+				max_moves = max(max_moves, op_moves);
+				b_moves_ok = b_moves_ok && (op_moves <= tiered_max_moves(tier_size, n));
+			}
+
+			if ((op % 10000) == 0)
+			{
+				// The bounds and searches agree with the reference
+				for (int key = 0; key < 200; key++)
+				{
+					Counted const e(rand() % 50001);
+					int const lower = lower_bound(ref.begin(), ref.end(), e.value) - ref.begin();
+					int const upper = upper_bound(ref.begin(), ref.end(), e.value) - ref.begin();
+					int const found = ((lower < n) && (ref[lower] == e.value)) ? lower : ~lower;
+					b_ok = b_ok && (T.LowerBound(e) == lower) && (T.UpperBound(e) == upper) && (T.BinSearch(e) == found);
+				}
+			}
+		}
+	}
+
+	for (int i = 0; b_ok && (i < T.Length()); i++) b_ok = (T[i].value == ref[i]);
+
+	// Erase the rest in random order
+	random_shuffle(ref.begin(), ref.end());
+	for (int value : ref) b_ok = b_ok && T.EraseSorted(value);
+	b_ok = b_ok && (T.Length() == 0) && !T.EraseSorted(0);
+
+	check(b_ok, "TieredCDA stays sorted");
+	check(b_moves_ok, "TieredCDA moves O(sqrt(N)) elements per operation");
+	check(T.TierSize() == 16, "TieredCDA shrinks its tiers as it shrinks");
+	cout << "Most moves in one TieredCDA operation: " << max_moves << endl;
+}
+
+int main()
+{
+	srand(23);
+	test1();
+	test2();
+	return report("SortedInsert");
+}
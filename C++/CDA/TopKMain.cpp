@@ -0,0 +1,128 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+using namespace std;
+#include "../CDA.cpp"
+#include "../TopKStream.cpp"
+#include "Check.cpp"
+
+// Returns n random values from [0, range), so a small range gives many duplicates
+vector<int> random_values(int n, int range)
+{
+	vector<int> v(n);
+	for (int &e : v) e = rand() % range;
+	return v;
+}
+
+// PartialSort sorts the k smallest elements into the front and keeps the rest of them
+void test1()
+{
+	int const sizes[] = {0, 1, 2, 17, 100, 1000, 20000};
+	bool b_ok = true;
+
+	for (int n : sizes)
+	{
+		int const ks[] = {-1, 0, 1, 2, n / 3, n - 1, n, n + 5};
+
+		for (int k : ks)
+		{
+			vector<int> v = random_values(n, 1 + n / 2);
+			CDA<int> A;
+			fill_wrapped(A, v);
+
+			A.PartialSort(k);
+
+			vector<int> sorted = v;
+			sort(sorted.begin(), sorted.end());
+			int const top = max(0, min(k, n));
+
+			vector<int> rest;
+			for (int i = 0; i < A.Length(); i++) rest.push_back(A[i]);
+			for (int i = 0; i < top; i++) b_ok = b_ok && (A[i] == sorted[i]);
+
+			sort(rest.begin(), rest.end());
+			b_ok = b_ok && (A.Length() == n) && (rest == sorted);
+		}
+	}
+	check(b_ok, "PartialSort sorts the smallest elements into the front");
+}
+
+// TopK copies the k smallest elements, and no more than there are
+void test2()
+{
+	bool b_ok = true;
+
+	for (int n = 0; n <= 64; n++)
+	{
+		for (int k = 0; k <= n + 2; k++)
+		{
+			vector<int> v = random_values(n, 10);
+			CDA<int> A;
+			fill_wrapped(A, v);
+
+			vector<int> out(k + 1, -1);
+			int const count = A.TopK(k, out.data());
+
+			sort(v.begin(), v.end());
+			b_ok = b_ok && (count == min(k, n)) && (out[count] == -1);
+			for (int i = 0; i < count; i++) b_ok = b_ok && (out[i] == v[i]);
+		}
+	}
+	check(b_ok, "TopK copies the smallest elements");
+
+	CDA<string> words;
+	vector<string> ref;
+	for (int i = 0; i < 5000; i++)
+	{
+		string const word = to_string(rand() % 3000);
+		words.AddEnd(word);
+		ref.push_back(word);
+	}
+	vector<string> out(50);
+	sort(ref.begin(), ref.end());
+	check((words.TopK(50, out.data()) == 50) && equal(out.begin(), out.end(), ref.begin()), "TopK of strings");
+}
+
+// A stream gives the same k smallest elements as sorting everything added to it
+void test3()
+{
+	int const ks[] = {0, 1, 2, 10, 1000};
+	bool b_ok = true;
+
+	for (int k : ks)
+	{
+		TopKStream<int> stream(k);
+		vector<int> ref;
+
+		for (int batch = 0; batch < 50; batch++)
+		{
+			// Adds one at a time and in ranges, with values that rise and fall so the threshold is used
+			vector<int> v = random_values(rand() % 200, 1000 + 100 * (batch % 7));
+
+			if ((batch % 2) == 0) stream.AppendRange(v.data(), static_cast<int>(v.size()));
+			else for (int e : v) stream.AddEnd(e);
+
+			ref.insert(ref.end(), v.begin(), v.end());
+			sort(ref.begin(), ref.end());
+
+			int const expect = min(k, static_cast<int>(ref.size()));
+			vector<int> out(expect + 1, -1);
+
+			b_ok = b_ok && (stream.Length() == expect);
+			b_ok = b_ok && (stream.TopK(out.data()) == expect) && (out[expect] == -1);
+			for (int i = 0; i < expect; i++) b_ok = b_ok && (out[i] == ref[i]);
+		}
+	}
+	check(b_ok, "TopKStream keeps the smallest elements");
+}
+
+int main()
+{
+	srand(24);
+	test1();
+	test2();
+	test3();
+	return report("TopK");
+}
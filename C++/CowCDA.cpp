@@ -0,0 +1,392 @@
+/**
+ * @file CowCDA.cpp
+ *
+ * This file implements a copy-on-write version of the circular dynamic array. Copies of a #CowCDA
+ * share one reference counted #CDA, so taking a snapshot of a large array takes O(1) time. The
+ * shared #CDA is only cloned the first time a copy is changed while another copy still refers to it.
+ * Because the whole #CDA is shared, an array that was initialized in constant time shares its init
+ * tracker as well.
+ *
+ * Functions that can change the array clone it first if it is shared. The read only functions,
+ * #Read(), #Search(), #Count(), #FindAll(), #BinSearch() and #ForEach(), never change the shared
+ * #CDA, so several threads can read their own copies at the same time.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for CowCDA.cpp
+#ifndef COW_CDA_CPP
+#define COW_CDA_CPP
+
+#include <memory>
+#include <utility>
+
+#include "CDA.cpp"
+
+using namespace std;
+
+template <typename elmtype, typename capacity_policy = GeneralCapacity, typename init_tracker = SplitInitTracker,
+          typename error_policy = PrintOnError>
+
+class CowCDA
+{
+    private:
+
+        typedef CDA<elmtype, capacity_policy, init_tracker, error_policy> array_type;
+
+        shared_ptr<array_type> shared_arr; ///< The array, which may be shared with other copies.
+
+        /**
+         * Clones the array if any other copy refers to it, so that it can be changed.
+         *
+         * @return The array, which is no longer shared.
+         */
+        array_type & Detach()
+        {
+            if (shared_arr.use_count() > 1)
+            {
+                shared_arr = make_shared<array_type>(*shared_arr);
+            }
+
+            return *shared_arr;
+        }
+
+    public:
+
+        /**
+         * The default constructor, creates an empty array with a capacity of 1.
+         */
+        CowCDA() : shared_arr(make_shared<array_type>())
+        {
+        }
+
+        /**
+         * Constructor that creates an array of s default constructed elements.
+         *
+         * @param[in] s The size of the array.
+         */
+        CowCDA(int s) : shared_arr(make_shared<array_type>(s))
+        {
+        }
+
+        /**
+         * Constructor that creates an array of s elements that act as though they were initialized
+         * with the value init, in O(1) time.
+         *
+         * @param[in] s    The size of the array.
+         * @param[in] init The value that the array should act as though it has been initialized with.
+         */
+        CowCDA(int s, elmtype init) : shared_arr(make_shared<array_type>(s, init))
+        {
+        }
+
+        /**
+         * Copy constructor, which shares the array of the other object in O(1) time.
+         *
+         * @param[in] obj_being_copied The CowCDA object to share the array of.
+         */
+        CowCDA(const CowCDA & obj_being_copied) : shared_arr(obj_being_copied.shared_arr)
+        {
+        }
+
+        /**
+         * Copy Assignment operator, which shares the array of the other object in O(1) time.
+         *
+         * @param[in] obj_being_copied The CowCDA object to share the array of.
+         *
+         * @return A reference to this object.
+         */
+        CowCDA& operator=(const CowCDA & obj_being_copied)
+        {
+            shared_arr = obj_being_copied.shared_arr;
+
+            return *this;
+        }
+
+        /**
+         * Returns true if another copy shares the array, so the next change will clone it.
+         */
+        bool Shared()
+        {
+            return shared_arr.use_count() > 1;
+        }
+
+        /**
+         * Returns the size of the array.
+         */
+        int Length()
+        {
+            return shared_arr->Length();
+        }
+
+        /**
+         * Returns the capacity of the array.
+         */
+        int Capacity()
+        {
+            return shared_arr->Capacity();
+        }
+
+        /**
+         * Returns the settings that control when the array grows and shrinks.
+         */
+        ResizePolicy GetResizePolicy()
+        {
+            return shared_arr->GetResizePolicy();
+        }
+
+        /**
+         * Reads an element without changing or cloning the array.
+         *
+         * @param[in] idx The index of the element to read.
+         *
+         * @return A const reference to the element, which stays valid until the array is changed.
+         */
+        const elmtype &Read(int idx)
+        {
+            return shared_arr->Read(idx);
+        }
+
+        /**
+         * Calls the visitor with a const reference to each element of the array, in order, without
+         * changing or cloning the array.
+         *
+         * @param[in] visit A function or functor called as visit(elm).
+         */
+        template <typename visitor>
+        void ForEach(visitor visit)
+        {
+            array_type & arr = *shared_arr;
+
+            for (int idx = 0; idx < arr.Length(); idx++)
+            {
+                visit(arr.Read(idx));
+            }
+        }
+
+        /**
+         * Returns a reference to an element, cloning the array first if it is shared.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to the element.
+         *
+         * @note The reference must not be written through after this object has been copied, as the
+         *       copy would see the change. Use #Read() for reads that shouldn't clone the array.
+         */
+        elmtype &operator[](int idx)
+        {
+            return Detach()[idx];
+        }
+
+        /**
+         * Checked accessor, cloning the array first if it is shared.
+         *
+         * @throws out_of_range The index is out of bounds.
+         */
+        elmtype &At(int idx)
+        {
+            return Detach().At(idx);
+        }
+
+        /**
+         * Adds an element to the back of the array, cloning the array first if it is shared.
+         */
+        void AddEnd(const elmtype & data_val)
+        {
+            Detach().AddEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the array, cloning the array first if it is shared.
+         */
+        void AddEnd(elmtype && data_val)
+        {
+            Detach().AddEnd(move(data_val));
+        }
+
+        /**
+         * Constructs an element at the back of the array, cloning the array first if it is shared.
+         */
+        template <typename... arg_types>
+        void EmplaceEnd(arg_types &&... args)
+        {
+            Detach().EmplaceEnd(forward<arg_types>(args)...);
+        }
+
+        /**
+         * Adds an element to the front of the array, cloning the array first if it is shared.
+         */
+        void AddFront(const elmtype & data_val)
+        {
+            Detach().AddFront(data_val);
+        }
+
+        /**
+         * Moves an element to the front of the array, cloning the array first if it is shared.
+         */
+        void AddFront(elmtype && data_val)
+        {
+            Detach().AddFront(move(data_val));
+        }
+
+        /**
+         * Constructs an element at the front of the array, cloning the array first if it is shared.
+         */
+        template <typename... arg_types>
+        void EmplaceFront(arg_types &&... args)
+        {
+            Detach().EmplaceFront(forward<arg_types>(args)...);
+        }
+
+        /**
+         * Deletes the back element, cloning the array first if it is shared.
+         */
+        void DelEnd()
+        {
+            Detach().DelEnd();
+        }
+
+        /**
+         * Deletes the front element, cloning the array first if it is shared.
+         */
+        void DelFront()
+        {
+            Detach().DelFront();
+        }
+
+        /**
+         * Adds a range of elements to the back of the array, cloning the array first if it is shared.
+         * The range may come from this array or a copy of it.
+         */
+        void AppendRange(const elmtype * src, int n)
+        {
+            Detach().AppendRange(src, n);
+        }
+
+        /**
+         * Adds a range of elements to the front of the array, cloning the array first if it is shared.
+         * The range may come from this array or a copy of it.
+         */
+        void PrependRange(const elmtype * src, int n)
+        {
+            Detach().PrependRange(src, n);
+        }
+
+        /**
+         * Deletes n elements from the front, cloning the array first if it is shared.
+         */
+        void DropFront(int n)
+        {
+            Detach().DropFront(n);
+        }
+
+        /**
+         * Deletes n elements from the back, cloning the array first if it is shared.
+         */
+        void DropBack(int n)
+        {
+            Detach().DropBack(n);
+        }
+
+        /**
+         * Changes when the array grows and shrinks, cloning the array first if it is shared.
+         */
+        void SetResizePolicy(const ResizePolicy & policy)
+        {
+            Detach().SetResizePolicy(policy);
+        }
+
+        /**
+         * Makes room for at least n elements, cloning the array first if it is shared.
+         */
+        void Reserve(int n)
+        {
+            Detach().Reserve(n);
+        }
+
+        /**
+         * Shrinks the capacity to fit the elements, cloning the array first if it is shared.
+         */
+        void ShrinkToFit()
+        {
+            Detach().ShrinkToFit();
+        }
+
+        /**
+         * Sorts the array, cloning it first if it is shared.
+         */
+        void Sort()
+        {
+            Detach().Sort();
+        }
+
+        /**
+         * Sorts the array with several threads, cloning it first if it is shared.
+         */
+        void ParallelSort(int threads)
+        {
+            Detach().ParallelSort(threads);
+        }
+
+        /**
+         * Returns the kth smallest element. Selection partitions the array, so it is cloned first if it
+         * is shared.
+         */
+        elmtype Select(int k)
+        {
+            return Detach().Select(k);
+        }
+
+        /**
+         * Selects the k1th and k2th smallest elements, cloning the array first if it is shared.
+         */
+        void SelectRange(int k1, int k2)
+        {
+            Detach().SelectRange(k1, k2);
+        }
+
+        /**
+         * Selects several ranks at once, cloning the array first if it is shared.
+         */
+        void SelectMany(const int * ranks, int n, elmtype * out)
+        {
+            Detach().SelectMany(ranks, n, out);
+        }
+
+        /**
+         * Performs a binary search on a sorted array without cloning it.
+         */
+        int BinSearch(elmtype e)
+        {
+            return shared_arr->BinSearch(e);
+        }
+
+        /**
+         * Returns the index of the first element equal to e, or -1, without cloning the array.
+         */
+        int Search(elmtype e)
+        {
+            return shared_arr->Search(e);
+        }
+
+        /**
+         * Counts the elements equal to e without cloning the array.
+         */
+        int Count(elmtype e)
+        {
+            return shared_arr->Count(e);
+        }
+
+        /**
+         * Adds the index of every element equal to e to out, without cloning the array.
+         */
+        template <typename out_policy>
+        void FindAll(elmtype e, CDA<int, out_policy> & out)
+        {
+            shared_arr->FindAll(e, out);
+        }
+};
+
+// End of include guard for COW_CDA_CPP
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file ErrorPolicy.cpp
+ *
+ * This file implements the error policies that decide what the circular dynamic arrays do when they
+ * are indexed out of bounds. Every policy has one function, InBounds(idx, size), which returns true
+ * if the access should go ahead, and false if it should return a reference to a spare value instead.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for ErrorPolicy.cpp
+#ifndef ERROR_POLICY_CPP
+#define ERROR_POLICY_CPP
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Error policy that prints a message when an array is indexed out of bounds, and has the access
+ * return a reference to a spare value instead.
+ */
+struct PrintOnError
+{
+    /**
+     * Checks an index against the size of the array.
+     *
+     * @param[in] idx  The index being accessed.
+     * @param[in] size The number of elements in the array.
+     *
+     * @retval true  The index is in bounds.
+     * @retval false The index is out of bounds, and the spare value should be returned.
+     */
+    static bool InBounds(int idx, int size)
+    {
+        // A single unsigned compare rejects negative indexes as well
+        if (static_cast<unsigned>(idx) < static_cast<unsigned>(size))
+        {
+            return true;
+        }
+
+        cout << "Index out of bounds!\n";
+        return false;
+    }
+};
+
+/**
+ * Error policy that does not check indexes at all, so an access is only the load. Indexing out of
+ * bounds is undefined behavior.
+ */
+struct UncheckedAccess
+{
+    static bool InBounds(int, int)
+    {
+        return true;
+    }
+};
+
+/**
+ * Error policy that checks indexes with an assert, so they are only checked in debug builds and
+ * release builds compile down to the load.
+ */
+struct AssertOnError
+{
+    static bool InBounds(int idx, int size)
+    {
+        assert((static_cast<unsigned>(idx) < static_cast<unsigned>(size)) && "Index out of bounds!");
+        (void)idx;
+        (void)size;
+
+        return true;
+    }
+};
+
+/**
+ * Error policy that throws an out_of_range exception when an index is out of bounds.
+ */
+struct ThrowOnError
+{
+    static bool InBounds(int idx, int size)
+    {
+        if (static_cast<unsigned>(idx) >= static_cast<unsigned>(size))
+        {
+            throw out_of_range("Index out of bounds!");
+        }
+
+        return true;
+    }
+};
+
+/**
+ * Error policy that calls a handler when an index is out of bounds. If the handler returns, the
+ * access returns a reference to a spare value.
+ *
+ * @tparam handler The function to call with the index and the size of the array.
+ */
+template <void (*handler)(int idx, int size)>
+struct CallbackOnError
+{
+    static bool InBounds(int idx, int size)
+    {
+        if (static_cast<unsigned>(idx) < static_cast<unsigned>(size))
+        {
+            return true;
+        }
+
+        handler(idx, size);
+        return false;
+    }
+};
+
+// End of include guard for ERROR_POLICY_CPP
+#endif
@@ -10,17 +10,20 @@
 #include <iostream>
 
 #include "CDA.cpp"
+#include "SegmentedCDA.cpp"
 
 using namespace std;
 
-template<typename keytype>
+template<typename keytype, typename array_type = CDA<keytype, GeneralCapacity, SplitInitTracker, AssertOnError> >
 
 class Heap
 {
     private:
 
-        /// Dynamic array that will store the heap data structure.
-        CDA<keytype> heap_arr;
+        /// Dynamic array that will store the heap data structure. A SegmentedCDA can be used instead
+        /// to avoid copying the whole heap when the array grows. The heap only indexes keys below
+        /// #insert_index, so by default the array's indexes are only checked in debug builds.
+        array_type heap_arr;
 
         /// The index of the #heap_arr where a new key should be inserted.
         int insert_index;
@@ -132,7 +135,7 @@ class Heap
          */
         Heap(const Heap &obj_being_copied)
         {
-            // Uses the CDA's copy assignment operator, which performs a deep copy
+            // Uses the array's copy assignment operator, which performs a deep copy
             heap_arr     = obj_being_copied.heap_arr;
 
             insert_index = obj_being_copied.insert_index;
@@ -148,7 +151,7 @@ class Heap
          */
         Heap& operator=(const Heap &obj_being_copied)
         {
-            // Uses the CDA's copy assignment operator, which performs a deep copy
+            // Uses the array's copy assignment operator, which performs a deep copy
             heap_arr     = obj_being_copied.heap_arr;
 
             insert_index = obj_being_copied.insert_index;
@@ -264,7 +267,7 @@ class Heap
         void insert(keytype k)
         {
             // Insert the new k at the end of the array
-            heap_arr.AddEnd(k);
+            heap_arr.AddEnd(move(k));
 
             bool b_continue = true;
             int inserted_key_index = insert_index;
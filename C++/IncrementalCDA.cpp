@@ -0,0 +1,831 @@
+/**
+ * @file IncrementalCDA.cpp
+ *
+ * This file implements a version of the circular dynamic array that resizes incrementally, so that
+ * every operation takes O(1) time in the worst case.
+ *
+ * When the array needs to grow or shrink, the new array is allocated but the elements are left in the
+ * old one. Every later add or delete then moves a few of the remaining elements over, and the old
+ * array is freed once it is empty. Until then, an index is looked up in whichever array still holds
+ * it. The array is doubled when it is full and halved when it is 25% full, so the old elements are
+ * always moved over well before the next resize is needed.
+ *
+ * Indexes are checked by an error policy, as in the #CDA. The interface is the part of the #CDA that
+ * a real-time user needs: the adds and deletes at both ends, indexing, #Search(), #BinSearch(),
+ * #Sort() and #Select(). The last two take O(N log N) and O(N) time, so they are not meant to be
+ * called where the O(1) bound matters. The init constructor fills the array straight away rather
+ * than in constant time, and the bulk range operations, iterators and resize policies of the #CDA are
+ * not provided.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for IncrementalCDA.cpp
+#ifndef INCREMENTAL_CDA_CPP
+#define INCREMENTAL_CDA_CPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ErrorPolicy.cpp"
+#include "IntroSelect.cpp"
+#include "MergeSort.cpp"
+#include "RadixSort.cpp"
+
+using namespace std;
+
+template <typename elmtype, typename error_policy = PrintOnError>
+
+class IncrementalCDA
+{
+    static_assert(alignof(elmtype) <= alignof(max_align_t), "IncrementalCDA storage is not aligned for this type");
+
+    private:
+
+        static const int migrate_step = 4; ///< The number of old elements moved over by each operation.
+
+        int user_size    = 0;            ///< The number of elements that the user has access to.
+        int arr_capacity = 0;            ///< The capacity of the #data_array, always a power of two.
+        int front_idx    = 0;            ///< The index of the front element in the #data_array.
+
+        elmtype * data_array = NULL;     ///< The raw storage where the elements are kept.
+
+        elmtype * old_array    = NULL;   ///< The storage from before the last resize, until it is empty.
+        int       old_capacity = 0;      ///< The capacity of the #old_array.
+        int       old_front    = 0;      ///< The index of the #old_array that maps to index 0 of the #data_array.
+
+        int mig_lo = 0;                  ///< The start of the indexes of the #data_array still held by the #old_array.
+        int mig_hi = 0;                  ///< The end of the indexes of the #data_array still held by the #old_array.
+
+        elmtype ref_val;                 ///< Reference value returned when the #error_policy rejects an index
+
+        /**
+         * Allocates raw storage. No elements are constructed.
+         */
+        static elmtype * Allocate(int capacity)
+        {
+            return static_cast<elmtype *>(::operator new(capacity * sizeof(elmtype)));
+        }
+
+        /**
+         * Frees storage that was allocated with #Allocate().
+         */
+        static void Deallocate(elmtype * storage)
+        {
+            ::operator delete(static_cast<void *>(storage));
+        }
+
+        /**
+         * Returns true if an index of the #data_array is still held by the #old_array.
+         */
+        bool IsOld(int idx) const
+        {
+            return (idx >= mig_lo) && (idx < mig_hi);
+        }
+
+        /**
+         * Returns a pointer to the element at an index of the #data_array, which may still be held by
+         * the #old_array.
+         */
+        elmtype * Slot(int idx) const
+        {
+            if (IsOld(idx))
+            {
+                return old_array + ((old_front + idx) & (old_capacity - 1));
+            }
+
+            return data_array + idx;
+        }
+
+        /**
+         * Returns the index of the #data_array for an index of the array.
+         */
+        int DataIdx(int idx) const
+        {
+            return (front_idx + idx) & (arr_capacity - 1);
+        }
+
+        /**
+         * Moves up to #migrate_step elements from the #old_array to the #data_array, and frees the
+         * #old_array once it is empty.
+         *
+         * @param[in] steps The largest number of elements to move.
+         */
+        void Migrate(int steps)
+        {
+            if (NULL == old_array)
+            {
+                return;
+            }
+
+            for (int step = 0; (step < steps) && (mig_lo < mig_hi); step++)
+            {
+                elmtype * old_elm = old_array + ((old_front + mig_lo) & (old_capacity - 1));
+
+                ::new (static_cast<void *>(data_array + mig_lo)) elmtype(move(*old_elm));
+                old_elm->~elmtype();
+
+                mig_lo++;
+            }
+
+            if (mig_lo >= mig_hi)
+            {
+                Deallocate(old_array);
+
+                old_array = NULL;
+                mig_lo    = 0;
+                mig_hi    = 0;
+            }
+        }
+
+        /**
+         * Starts moving the elements to new storage of the given capacity. The current storage becomes
+         * the #old_array, and the elements are moved over by later operations.
+         *
+         * @param[in] new_arr_capacity The capacity of the new storage, which must be at least
+         *                             #user_size.
+         */
+        void StartResize(int new_arr_capacity)
+        {
+            // A resize only starts once the previous one has finished, so this only moves a few
+            // elements
+            Migrate(user_size);
+
+            old_array    = data_array;
+            old_capacity = arr_capacity;
+            old_front    = front_idx;
+
+            data_array   = Allocate(new_arr_capacity);
+            arr_capacity = new_arr_capacity;
+            front_idx    = 0;
+
+            // The elements keep their indexes, so they are placed at the start of the new storage
+            mig_lo = 0;
+            mig_hi = user_size;
+
+            // Nothing to move, the old storage can be freed straight away
+            Migrate(0);
+        }
+
+        /**
+         * Starts halving the array if it is only 25% full, without letting the capacity go below 4.
+         */
+        void CheckShrink()
+        {
+            if ((user_size == (arr_capacity / 4)) && ((arr_capacity / 2) >= 4))
+            {
+                StartResize(arr_capacity / 2);
+            }
+        }
+
+        /**
+         * Constructs a new element just past the back of the array. The array must not be full.
+         */
+        template <typename... arg_types>
+        void ConstructEnd(arg_types &&... args)
+        {
+            ::new (static_cast<void *>(data_array + DataIdx(user_size))) elmtype(forward<arg_types>(args)...);
+
+            user_size++;
+
+            Migrate(migrate_step);
+        }
+
+        /**
+         * Constructs a new element just before the front of the array. The array must not be full.
+         */
+        template <typename... arg_types>
+        void ConstructFront(arg_types &&... args)
+        {
+            int const idx = (front_idx - 1) & (arr_capacity - 1);
+
+            ::new (static_cast<void *>(data_array + idx)) elmtype(forward<arg_types>(args)...);
+
+            front_idx = idx;
+            user_size++;
+
+            Migrate(migrate_step);
+        }
+
+        /**
+         * Destroys every element and frees both arrays.
+         */
+        void FreeArrays()
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                Slot(DataIdx(idx))->~elmtype();
+            }
+
+            Deallocate(data_array);
+            Deallocate(old_array);
+
+            data_array = NULL;
+            old_array  = NULL;
+            mig_lo     = 0;
+            mig_hi     = 0;
+        }
+
+        /**
+         * Copies the elements of another IncrementalCDA object into new storage of the same capacity,
+         * starting at index 0.
+         *
+         * @note Any prior arrays must already have been freed.
+         */
+        void CopyArrays(IncrementalCDA const & obj_being_copied)
+        {
+            user_size    = obj_being_copied.user_size;
+            arr_capacity = obj_being_copied.arr_capacity;
+            front_idx    = 0;
+            ref_val      = obj_being_copied.ref_val;
+
+            data_array = Allocate(arr_capacity);
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                ::new (static_cast<void *>(data_array + idx)) elmtype(*obj_being_copied.Slot(obj_being_copied.DataIdx(idx)));
+            }
+        }
+
+        /**
+         * Takes the arrays and attributes of another IncrementalCDA object, leaving it empty with a
+         * capacity of 0.
+         */
+        void TakeArrays(IncrementalCDA & obj_being_moved)
+        {
+            user_size    = obj_being_moved.user_size;
+            arr_capacity = obj_being_moved.arr_capacity;
+            front_idx    = obj_being_moved.front_idx;
+            data_array   = obj_being_moved.data_array;
+            old_array    = obj_being_moved.old_array;
+            old_capacity = obj_being_moved.old_capacity;
+            old_front    = obj_being_moved.old_front;
+            mig_lo       = obj_being_moved.mig_lo;
+            mig_hi       = obj_being_moved.mig_hi;
+
+            // Leave the other object as an empty array that can still be used
+            obj_being_moved.user_size    = 0;
+            obj_being_moved.arr_capacity = 0;
+            obj_being_moved.front_idx    = 0;
+            obj_being_moved.data_array   = NULL;
+            obj_being_moved.old_array    = NULL;
+            obj_being_moved.mig_lo       = 0;
+            obj_being_moved.mig_hi       = 0;
+        }
+
+        /**
+         * Finishes moving the elements over from before the last resize, and moves every element into
+         * a new plain array, in order. The array is raw storage that the elements are move constructed
+         * into, so no element is ever default constructed.
+         *
+         * @return The plain array, which must be freed with BottomUpMergeSorter::FreeScratch().
+         */
+        elmtype * MoveOut()
+        {
+            Migrate(user_size);
+
+            elmtype * dest = Allocate(user_size);
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                ::new (static_cast<void *>(dest + idx)) elmtype(move(data_array[DataIdx(idx)]));
+            }
+
+            return dest;
+        }
+
+        /**
+         * Moves the elements of a plain array back into the array, in order.
+         */
+        void MoveIn(elmtype * src)
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                data_array[DataIdx(idx)] = move(src[idx]);
+            }
+        }
+
+        /**
+         * Sorts a plain array of an integral or floating point type with the radix sort. The scratch
+         * array is raw storage, which is fine for these types.
+         */
+        static void SortImpl(elmtype * data, int n, true_type)
+        {
+            elmtype * scratch = Allocate(n);
+
+            RadixSorter<elmtype>::Sort(data, n, data, 0, data, scratch);
+
+            Deallocate(scratch);
+        }
+
+        /**
+         * Sorts a plain array of any other type with the merge sort.
+         */
+        static void SortImpl(elmtype * data, int n, false_type)
+        {
+            BottomUpMergeSorter<elmtype>::SortInPlace(data, n);
+        }
+
+    public:
+
+        /**
+         * The default constructor, sets the arr_capacity to 1, and user_size to 0.
+         */
+        IncrementalCDA(void)
+        {
+            arr_capacity = 1;
+            data_array   = Allocate(1);
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s.
+         *
+         * @param[in] s The number of elements in the array.
+         *
+         * @note The capacity is rounded up to the next power of two.
+         */
+        IncrementalCDA(int s)
+        {
+            arr_capacity = 1;
+
+            while (arr_capacity < s)
+            {
+                arr_capacity <<= 1;
+            }
+
+            user_size  = s;
+            data_array = Allocate(arr_capacity);
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                ::new (static_cast<void *>(data_array + idx)) elmtype;
+            }
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s with every element set to init.
+         *
+         * @param[in] s    The number of elements in the array.
+         * @param[in] init The value that every element is initialized to.
+         *
+         * @note Takes O(s) time, as the elements are copy constructed straight away.
+         */
+        IncrementalCDA(int s, elmtype init)
+        {
+            arr_capacity = 1;
+
+            while (arr_capacity < s)
+            {
+                arr_capacity <<= 1;
+            }
+
+            user_size  = s;
+            data_array = Allocate(arr_capacity);
+
+            uninitialized_fill(data_array, data_array + user_size, init);
+        }
+
+        /**
+         * Copy constructor for the IncrementalCDA class.
+         *
+         * @param[in] obj_being_copied A reference to an IncrementalCDA object that should be used to
+         *                             create a new IncrementalCDA object.
+         */
+        IncrementalCDA(const IncrementalCDA & obj_being_copied)
+        {
+            CopyArrays(obj_being_copied);
+        }
+
+        /**
+         * Move constructor for the IncrementalCDA class.
+         *
+         * @param[in] obj_being_moved An IncrementalCDA object whose arrays should be used to create a
+         *                            new IncrementalCDA object. It is left empty, with a capacity of 0.
+         */
+        IncrementalCDA(IncrementalCDA && obj_being_moved) noexcept
+        {
+            TakeArrays(obj_being_moved);
+        }
+
+        /**
+         * Copy Assignment operator.
+         *
+         * @param[in] obj_being_copied A reference to an IncrementalCDA object that is going to be
+         *                             copied over.
+         *
+         * @return A reference to an updated IncrementalCDA object that matches #obj_being_copied.
+         */
+        IncrementalCDA& operator=(const IncrementalCDA & obj_being_copied)
+        {
+            if (this != &obj_being_copied)
+            {
+                FreeArrays();
+                CopyArrays(obj_being_copied);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Move Assignment operator.
+         *
+         * @param[in] obj_being_moved An IncrementalCDA object whose arrays should be moved over. It is
+         *                            left empty, with a capacity of 0.
+         *
+         * @return A reference to an updated IncrementalCDA object that matches what #obj_being_moved
+         *         was.
+         */
+        IncrementalCDA& operator=(IncrementalCDA && obj_being_moved) noexcept
+        {
+            if (this != &obj_being_moved)
+            {
+                FreeArrays();
+                TakeArrays(obj_being_moved);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Destructor for the IncrementalCDA class.
+         */
+        ~IncrementalCDA()
+        {
+            FreeArrays();
+        }
+
+        /**
+         * Returns the size of the array.
+         *
+         * @return The size of the array that the user has access to.
+         */
+        int Length()
+        {
+            return user_size;
+        }
+
+        /**
+         * Returns the capacity of the array.
+         *
+         * @return The capacity of the newest storage.
+         */
+        int Capacity()
+        {
+            return arr_capacity;
+        }
+
+        /**
+         * Returns whether elements are still being moved over from before the last resize.
+         *
+         * @retval true  Some elements are still held by the old storage.
+         * @retval false Every element is held by the newest storage.
+         */
+        bool Resizing()
+        {
+            return NULL != old_array;
+        }
+
+        /**
+         * Overload version of the [] operator for the IncrementalCDA class. The index is checked by the
+         * #error_policy.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to the element, or to #ref_val if the #error_policy rejects the index.
+         */
+        elmtype &operator[](int idx)
+        {
+            if (!error_policy::InBounds(idx, user_size)) //< If the idx is out of the accesible range.
+            {
+                return ref_val;
+            }
+
+            return *Slot(DataIdx(idx));
+        }
+
+        /**
+         * Checked accessor that always checks the index, whatever the #error_policy is.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to the element.
+         *
+         * @throws out_of_range The index is out of bounds.
+         */
+        elmtype &At(int idx)
+        {
+            ThrowOnError::InBounds(idx, user_size);
+
+            return *Slot(DataIdx(idx));
+        }
+
+        /**
+         * Adds an element to the back of the array.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         *
+         * @note Takes O(1) time in the worst case. A full array starts doubling, and the elements are
+         *       moved over by this and later operations.
+         */
+        void AddEnd(const elmtype & data_val)
+        {
+            EmplaceEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the array.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array.
+         */
+        void AddEnd(elmtype && data_val)
+        {
+            EmplaceEnd(move(data_val));
+        }
+
+        /**
+         * Constructs an element from the given arguments in place at the back of the array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         */
+        template <typename... arg_types>
+        void EmplaceEnd(arg_types &&... args)
+        {
+            if (user_size == arr_capacity)
+            {
+                // The arguments could refer to elements of this array, so build the element before the
+                // array is resized
+                elmtype val(forward<arg_types>(args)...);
+
+                StartResize(max(1, 2 * arr_capacity));
+                ConstructEnd(move(val));
+            }
+            else
+            {
+                ConstructEnd(forward<arg_types>(args)...);
+            }
+        }
+
+        /**
+         * Adds an element to the front of the array.
+         *
+         * @param[in] v The data element to be added to the front of the array.
+         *
+         * @note Takes O(1) time in the worst case. A full array starts doubling, and the elements are
+         *       moved over by this and later operations.
+         */
+        void AddFront(const elmtype & v)
+        {
+            EmplaceFront(v);
+        }
+
+        /**
+         * Moves an element to the front of the array.
+         *
+         * @param[in] v The data element to be moved to the front of the array.
+         */
+        void AddFront(elmtype && v)
+        {
+            EmplaceFront(move(v));
+        }
+
+        /**
+         * Constructs an element from the given arguments in place at the front of the array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         */
+        template <typename... arg_types>
+        void EmplaceFront(arg_types &&... args)
+        {
+            if (user_size == arr_capacity)
+            {
+                // The arguments could refer to elements of this array, so build the element before the
+                // array is resized
+                elmtype val(forward<arg_types>(args)...);
+
+                StartResize(max(1, 2 * arr_capacity));
+                ConstructFront(move(val));
+            }
+            else
+            {
+                ConstructFront(forward<arg_types>(args)...);
+            }
+        }
+
+        /**
+         * Deletes the back element of the array.
+         *
+         * @note Takes O(1) time in the worst case. If the array is only 25% full after the delete, it
+         *       starts halving.
+         */
+        void DelEnd()
+        {
+            // If the array is empty, don't do anything
+            if (user_size == 0)
+            {
+                return;
+            }
+
+            int const idx = DataIdx(user_size - 1);
+
+            Slot(idx)->~elmtype();
+
+            // The back element can only be the last of the old elements
+            if (IsOld(idx))
+            {
+                mig_hi--;
+            }
+
+            user_size--;
+
+            Migrate(migrate_step);
+            CheckShrink();
+        }
+
+        /**
+         * Deletes the front element of the array.
+         *
+         * @note Takes O(1) time in the worst case. If the array is only 25% full after the delete, it
+         *       starts halving.
+         */
+        void DelFront()
+        {
+            // If the array is empty, don't do anything
+            if (user_size == 0)
+            {
+                return;
+            }
+
+            Slot(front_idx)->~elmtype();
+
+            // The front element can only be the first of the old elements
+            if (IsOld(front_idx))
+            {
+                mig_lo++;
+            }
+
+            front_idx = DataIdx(1);
+            user_size--;
+
+            Migrate(migrate_step);
+            CheckShrink();
+        }
+
+        /**
+         * Calls the visitor once for each element of the array, in order.
+         *
+         * @param[in] visit A function or functor called as visit(elm) with a reference to each element.
+         */
+        template <typename visitor>
+        void ForEach(visitor visit)
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                visit(*Slot(DataIdx(idx)));
+            }
+        }
+
+        /**
+         * Performs a linear search of the array looking for the specified item.
+         *
+         * @param[in] e The elmtype value to look for in the array.
+         *
+         * @return The index of the item if found, or -1 if the item was not in the array.
+         */
+        int Search(elmtype e)
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                if (e == *Slot(DataIdx(idx)))
+                {
+                    return idx;
+                }
+            }
+
+            return -1;
+        }
+
+        /**
+         * Performs a binary search on a sorted array looking for item e.
+         *
+         * @param[in] e The elmtype value to look for in the array.
+         *
+         * @return The index of the first item equal to e if found, otherwise a negative number that is
+         *         the bitwise complement of the index of the next element that is larger than e or, if
+         *         there is no larger element, the bitwise complement of size.
+         */
+        int BinSearch(elmtype e)
+        {
+            int lower_bound = 0;
+            int upper_bound = user_size;
+
+            while (lower_bound < upper_bound)
+            {
+                int const mid = lower_bound + ((upper_bound - lower_bound) / 2);
+
+                if (*Slot(DataIdx(mid)) < e)
+                {
+                    lower_bound = mid + 1;
+                }
+                else
+                {
+                    upper_bound = mid;
+                }
+            }
+
+            if ((lower_bound < user_size) && (*Slot(DataIdx(lower_bound)) == e))
+            {
+                return lower_bound;
+            }
+
+            return ~lower_bound;
+        }
+
+        /**
+         * Sorts the array. The elements still held by the old storage are moved over first, and the
+         * elements are then moved into one contiguous array, sorted there with the radix sort for
+         * integral and floating point types or the merge sort otherwise, and moved back.
+         *
+         * @note Takes O(N log N) time, or O(N) for the radix sort, so it breaks the O(1) bound of the
+         *       other operations.
+         */
+        void Sort()
+        {
+            if (user_size < 2)
+            {
+                return;
+            }
+
+            elmtype * data = MoveOut();
+
+            SortImpl(data, user_size, integral_constant<bool, RadixKey<elmtype>::b_sortable>());
+            MoveIn(data);
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(data, user_size);
+        }
+
+        /**
+         * Function that selects the kth smallest element in the array.
+         *
+         * @note Afterwards, the kth smallest element is at index k - 1, with no larger element before it
+         *       and no smaller element after it.
+         *
+         * @note Takes O(N) time, so it breaks the O(1) bound of the other operations.
+         *
+         * @param[in] k An integer signaling which smallest element the user is looking for.
+         *
+         * @return The kth smallest element in the array, or #ref_val if the #error_policy rejects k.
+         */
+        elmtype Select(int k)
+        {
+            if (!error_policy::InBounds(k - 1, user_size))
+            {
+                return ref_val;
+            }
+
+            elmtype * data = MoveOut();
+
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(k));
+            selector.Select(data, 0, user_size, k - 1);
+
+            MoveIn(data);
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(data, user_size);
+
+            return *Slot(DataIdx(k - 1));
+        }
+
+        /*********************************
+         * Debug Functions
+         *********************************/
+
+        /**
+         * Displays information regarding the arrays.
+         */
+        void ArrayCheck()
+        {
+            cout << "Front Index: "    << front_idx         << endl;
+            cout << "User Size: "      << user_size         << endl;
+            cout << "Array Capacity: " << arr_capacity      << endl;
+            cout << "Old Elements: "   << (mig_hi - mig_lo) << endl;
+        }
+
+        /**
+         * Displays the contents of the array.
+         */
+        void DisplayArrayContents()
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                cout << *Slot(DataIdx(idx)) << " ";
+            }
+
+            cout << endl;
+        }
+};
+
+// End of include guard for INCREMENTAL_CDA_CPP
+#endif
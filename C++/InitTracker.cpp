@@ -0,0 +1,563 @@
+/**
+ * @file InitTracker.cpp
+ *
+ * This file implements the validity trackers that the #CDA uses when it is created with an init
+ * value. A tracker records which slots of the array have been changed, so that every other slot can
+ * act as though it holds the init value without the array ever being filled.
+ *
+ * Every tracker has the same interface, so the #CDA can be given any of them as a template
+ * parameter:
+ *
+ *   - Create(capacity) sets up an empty tracker for the given number of slots.
+ *   - Free() releases the tracker's memory.
+ *   - Copy(other) makes a deep copy of another tracker that has been freed or never created.
+ *   - Take(other) takes the memory of another tracker, leaving it empty.
+ *   - WasChanged(idx) checks a slot, Mark(idx) records an unchanged slot as changed, and
+ *     Unmark(idx) records a changed slot as unchanged again.
+ *   - Changed() returns the number of changed slots, and Display() prints the tracker's state.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for InitTracker.cpp
+#ifndef INIT_TRACKER_CPP
+#define INIT_TRACKER_CPP
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * The classic constant time initialization trick, with two separate arrays. The #idx_array holds,
+ * for each slot, the position in the #point_array that may point back to it. A slot has been
+ * changed only if that position is in use and points back to the slot, so neither array ever needs
+ * to be cleared.
+ *
+ * @note Checking a slot reads two arrays at unrelated positions, which is two cache misses on a
+ *       large array.
+ */
+class SplitInitTracker
+{
+    private:
+
+        int * idx_array    = NULL; ///< For each slot, the index of the #point_array entry that may point back to it.
+        int * point_array  = NULL; ///< The changed slots, in the order they were changed.
+        int   capacity     = 0;    ///< The number of slots being tracked.
+        int   elms_changed = 0;    ///< The number of entries of the #point_array in use.
+
+    public:
+
+        SplitInitTracker()
+        {
+        }
+
+        SplitInitTracker(const SplitInitTracker &) = delete;
+        SplitInitTracker& operator=(const SplitInitTracker &) = delete;
+
+        /**
+         * Sets up an empty tracker for a number of slots in O(1) time.
+         *
+         * @param[in] s The number of slots to track.
+         */
+        void Create(int s)
+        {
+            idx_array    = new int[s];
+            point_array  = new int[s];
+            capacity     = s;
+            elms_changed = 0;
+        }
+
+        /**
+         * Frees the arrays of the tracker.
+         */
+        void Free()
+        {
+            delete[] idx_array;
+            delete[] point_array;
+
+            idx_array    = NULL;
+            point_array  = NULL;
+            capacity     = 0;
+            elms_changed = 0;
+        }
+
+        /**
+         * Makes a deep copy of another tracker.
+         *
+         * @param[in] other The tracker to copy.
+         *
+         * @note The entries of the #idx_array can refer to any index, so the whole of both arrays is
+         *       copied.
+         */
+        void Copy(const SplitInitTracker & other)
+        {
+            Create(other.capacity);
+
+            memcpy(idx_array, other.idx_array, capacity * sizeof(int));
+            memcpy(point_array, other.point_array, capacity * sizeof(int));
+
+            elms_changed = other.elms_changed;
+        }
+
+        /**
+         * Takes the arrays of another tracker, leaving it empty.
+         *
+         * @param[in] other The tracker to take the arrays from.
+         */
+        void Take(SplitInitTracker & other)
+        {
+            idx_array    = other.idx_array;
+            point_array  = other.point_array;
+            capacity     = other.capacity;
+            elms_changed = other.elms_changed;
+
+            other.idx_array    = NULL;
+            other.point_array  = NULL;
+            other.capacity     = 0;
+            other.elms_changed = 0;
+        }
+
+        /**
+         * Checks whether a slot has been changed.
+         *
+         * @param[in] idx The slot to check.
+         *
+         * @retval true  The slot has been changed.
+         * @retval false The slot has not been changed.
+         */
+        bool WasChanged(int idx) const
+        {
+            // A single unsigned compare rejects both negative and unused positions
+            unsigned const point_idx = static_cast<unsigned>(idx_array[idx]);
+
+            return (point_idx < static_cast<unsigned>(elms_changed)) && (point_array[point_idx] == idx);
+        }
+
+        /**
+         * Records an unchanged slot as changed.
+         *
+         * @param[in] idx The slot that was changed.
+         */
+        void Mark(int idx)
+        {
+            idx_array[idx]            = elms_changed;
+            point_array[elms_changed] = idx;
+            elms_changed++;
+        }
+
+        /**
+         * Records a changed slot as unchanged, by moving the last entry of the #point_array into its
+         * place.
+         *
+         * @param[in] idx The changed slot.
+         */
+        void Unmark(int idx)
+        {
+            int const point_idx = idx_array[idx];
+            int const last_idx  = point_array[elms_changed - 1];
+
+            point_array[point_idx] = last_idx;
+            idx_array[last_idx]    = point_idx;
+            elms_changed--;
+        }
+
+        /**
+         * Returns the number of changed slots.
+         */
+        int Changed() const
+        {
+            return elms_changed;
+        }
+
+        /**
+         * Displays the #idx_array and the part of the #point_array in use.
+         */
+        void Display() const
+        {
+            for (int idx = 0; idx < capacity; idx++)
+            {
+                cout << idx_array[idx] << " ";
+            }
+
+            cout << endl;
+
+            for (int idx = 0; idx < elms_changed; idx++)
+            {
+                cout << point_array[idx] << " ";
+            }
+
+            cout << endl;
+        }
+};
+
+/**
+ * The same constant time initialization trick as the #SplitInitTracker, but the two entries for
+ * each position are kept next to each other in one array. Checking a slot whose entry points to a
+ * nearby position, such as a slot changed in order, then only touches one cache line.
+ */
+class InterleavedInitTracker
+{
+    private:
+
+        /**
+         * The two entries kept for one position.
+         */
+        struct Entry
+        {
+            int idx;   ///< The index of the entry whose point may point back to this slot.
+            int point; ///< The slot recorded at this position of the changed list.
+        };
+
+        Entry * entries      = NULL; ///< One entry per slot.
+        int     capacity     = 0;    ///< The number of slots being tracked.
+        int     elms_changed = 0;    ///< The number of positions of the changed list in use.
+
+    public:
+
+        InterleavedInitTracker()
+        {
+        }
+
+        InterleavedInitTracker(const InterleavedInitTracker &) = delete;
+        InterleavedInitTracker& operator=(const InterleavedInitTracker &) = delete;
+
+        /**
+         * Sets up an empty tracker for a number of slots in O(1) time.
+         *
+         * @param[in] s The number of slots to track.
+         */
+        void Create(int s)
+        {
+            entries      = new Entry[s];
+            capacity     = s;
+            elms_changed = 0;
+        }
+
+        /**
+         * Frees the array of the tracker.
+         */
+        void Free()
+        {
+            delete[] entries;
+
+            entries      = NULL;
+            capacity     = 0;
+            elms_changed = 0;
+        }
+
+        /**
+         * Makes a deep copy of another tracker.
+         *
+         * @param[in] other The tracker to copy.
+         */
+        void Copy(const InterleavedInitTracker & other)
+        {
+            Create(other.capacity);
+
+            memcpy(static_cast<void *>(entries), other.entries, capacity * sizeof(Entry));
+
+            elms_changed = other.elms_changed;
+        }
+
+        /**
+         * Takes the array of another tracker, leaving it empty.
+         *
+         * @param[in] other The tracker to take the array from.
+         */
+        void Take(InterleavedInitTracker & other)
+        {
+            entries      = other.entries;
+            capacity     = other.capacity;
+            elms_changed = other.elms_changed;
+
+            other.entries      = NULL;
+            other.capacity     = 0;
+            other.elms_changed = 0;
+        }
+
+        /**
+         * Checks whether a slot has been changed.
+         *
+         * @param[in] idx The slot to check.
+         *
+         * @retval true  The slot has been changed.
+         * @retval false The slot has not been changed.
+         */
+        bool WasChanged(int idx) const
+        {
+            unsigned const point_idx = static_cast<unsigned>(entries[idx].idx);
+
+            return (point_idx < static_cast<unsigned>(elms_changed)) && (entries[point_idx].point == idx);
+        }
+
+        /**
+         * Records an unchanged slot as changed.
+         *
+         * @param[in] idx The slot that was changed.
+         */
+        void Mark(int idx)
+        {
+            entries[idx].idx            = elms_changed;
+            entries[elms_changed].point = idx;
+            elms_changed++;
+        }
+
+        /**
+         * Records a changed slot as unchanged, by moving the last position of the changed list into
+         * its place.
+         *
+         * @param[in] idx The changed slot.
+         */
+        void Unmark(int idx)
+        {
+            int const point_idx = entries[idx].idx;
+            int const last_idx  = entries[elms_changed - 1].point;
+
+            entries[point_idx].point = last_idx;
+            entries[last_idx].idx    = point_idx;
+            elms_changed--;
+        }
+
+        /**
+         * Returns the number of changed slots.
+         */
+        int Changed() const
+        {
+            return elms_changed;
+        }
+
+        /**
+         * Displays the idx entries of every slot, then the changed list.
+         */
+        void Display() const
+        {
+            for (int idx = 0; idx < capacity; idx++)
+            {
+                cout << entries[idx].idx << " ";
+            }
+
+            cout << endl;
+
+            for (int idx = 0; idx < elms_changed; idx++)
+            {
+                cout << entries[idx].point << " ";
+            }
+
+            cout << endl;
+        }
+};
+
+/**
+ * Tracks changed slots with one bit per slot, which is 1/64th of the memory of the other trackers.
+ * The bitmap is split into blocks of #block_words words, and a small top level bitmap records
+ * which blocks have been cleared. Only the top level is cleared when the tracker is created, and a
+ * block is cleared the first time one of its slots is changed.
+ *
+ * @note Creating the tracker takes O(N / 32768) time rather than O(1), but for any array that fits
+ *       in memory that is a handful of words.
+ */
+class BitmapInitTracker
+{
+    private:
+
+        static const int block_words = 64; ///< The number of words of the bitmap cleared at once.
+
+        uint64_t * bits         = NULL; ///< One bit per slot, only valid in blocks that have been cleared.
+        uint64_t * block_bits   = NULL; ///< One bit per block of #bits, set once the block is cleared.
+        int        capacity     = 0;    ///< The number of slots being tracked.
+        int        elms_changed = 0;    ///< The number of bits that are set.
+
+        /**
+         * Returns the number of words in the bitmap.
+         */
+        int Words() const
+        {
+            return (capacity + 63) / 64;
+        }
+
+        /**
+         * Returns the number of words in the top level bitmap.
+         */
+        int BlockWords() const
+        {
+            int const blocks = (Words() + block_words - 1) / block_words;
+
+            return (blocks + 63) / 64;
+        }
+
+        /**
+         * Returns the number of words in the block of the bitmap starting at a word, which is less
+         * than #block_words only for the last block.
+         */
+        int BlockLen(int first) const
+        {
+            int const len = Words() - first;
+
+            return (len < block_words) ? len : block_words;
+        }
+
+        /**
+         * Returns true if the block holding a word of the bitmap has been cleared.
+         */
+        bool BlockCleared(int word) const
+        {
+            int const block = word / block_words;
+
+            return (block_bits[block / 64] >> (block % 64)) & 1;
+        }
+
+    public:
+
+        BitmapInitTracker()
+        {
+        }
+
+        BitmapInitTracker(const BitmapInitTracker &) = delete;
+        BitmapInitTracker& operator=(const BitmapInitTracker &) = delete;
+
+        /**
+         * Sets up an empty tracker for a number of slots. Only the top level bitmap is cleared.
+         *
+         * @param[in] s The number of slots to track.
+         */
+        void Create(int s)
+        {
+            capacity     = s;
+            elms_changed = 0;
+
+            bits       = new uint64_t[Words()];
+            block_bits = new uint64_t[BlockWords()];
+
+            memset(block_bits, 0, BlockWords() * sizeof(uint64_t));
+        }
+
+        /**
+         * Frees the bitmaps of the tracker.
+         */
+        void Free()
+        {
+            delete[] bits;
+            delete[] block_bits;
+
+            bits         = NULL;
+            block_bits   = NULL;
+            capacity     = 0;
+            elms_changed = 0;
+        }
+
+        /**
+         * Makes a deep copy of another tracker. Only the blocks that have been cleared are copied.
+         *
+         * @param[in] other The tracker to copy.
+         */
+        void Copy(const BitmapInitTracker & other)
+        {
+            Create(other.capacity);
+
+            memcpy(block_bits, other.block_bits, BlockWords() * sizeof(uint64_t));
+
+            for (int word = 0; word < Words(); word += block_words)
+            {
+                if (BlockCleared(word))
+                {
+                    memcpy(bits + word, other.bits + word, BlockLen(word) * sizeof(uint64_t));
+                }
+            }
+
+            elms_changed = other.elms_changed;
+        }
+
+        /**
+         * Takes the bitmaps of another tracker, leaving it empty.
+         *
+         * @param[in] other The tracker to take the bitmaps from.
+         */
+        void Take(BitmapInitTracker & other)
+        {
+            bits         = other.bits;
+            block_bits   = other.block_bits;
+            capacity     = other.capacity;
+            elms_changed = other.elms_changed;
+
+            other.bits         = NULL;
+            other.block_bits   = NULL;
+            other.capacity     = 0;
+            other.elms_changed = 0;
+        }
+
+        /**
+         * Checks whether a slot has been changed.
+         *
+         * @param[in] idx The slot to check.
+         *
+         * @retval true  The slot has been changed.
+         * @retval false The slot has not been changed.
+         */
+        bool WasChanged(int idx) const
+        {
+            int const word = idx / 64;
+
+            return BlockCleared(word) && ((bits[word] >> (idx % 64)) & 1);
+        }
+
+        /**
+         * Records an unchanged slot as changed, clearing its block first if this is the block's first
+         * change.
+         *
+         * @param[in] idx The slot that was changed.
+         */
+        void Mark(int idx)
+        {
+            int const word = idx / 64;
+
+            if (!BlockCleared(word))
+            {
+                int const block = word / block_words;
+                int const first = block * block_words;
+
+                memset(bits + first, 0, BlockLen(first) * sizeof(uint64_t));
+
+                block_bits[block / 64] |= uint64_t(1) << (block % 64);
+            }
+
+            bits[word] |= uint64_t(1) << (idx % 64);
+            elms_changed++;
+        }
+
+        /**
+         * Records a changed slot as unchanged.
+         *
+         * @param[in] idx The changed slot.
+         */
+        void Unmark(int idx)
+        {
+            bits[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+            elms_changed--;
+        }
+
+        /**
+         * Returns the number of changed slots.
+         */
+        int Changed() const
+        {
+            return elms_changed;
+        }
+
+        /**
+         * Displays a 1 for every changed slot and a 0 for every other slot.
+         */
+        void Display() const
+        {
+            for (int idx = 0; idx < capacity; idx++)
+            {
+                cout << (WasChanged(idx) ? 1 : 0);
+            }
+
+            cout << endl;
+        }
+};
+
+// End of include guard for INIT_TRACKER_CPP
+#endif
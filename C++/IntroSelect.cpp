@@ -0,0 +1,280 @@
+/**
+ * @file IntroSelect.cpp
+ *
+ * This file implements the selection algorithm used by the circular dynamic array.
+ *
+ * Each round picks a pivot with a median-of-3 (or for large sections, a ninther) of randomly chosen
+ * elements, and does a three-way partition so that runs of equal elements are handled in one pass.
+ * If too many rounds only remove a small part of the section, the remaining rounds use the median of
+ * medians as the pivot, which keeps the worst case linear.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for IntroSelect.cpp
+#ifndef INTRO_SELECT_CPP
+#define INTRO_SELECT_CPP
+
+#include <algorithm>
+
+using namespace std;
+
+template <typename elmtype>
+class IntroSelector
+{
+    private:
+
+        static const int small_section = 16;  ///< Sections this small are insertion sorted.
+        static const int ninther_min   = 128; ///< Sections this large use a ninther pivot.
+
+        unsigned rng_state; ///< State of the xorshift random number generator.
+
+        /**
+         * Returns the next number from the xorshift random number generator.
+         */
+        unsigned NextRandom()
+        {
+            rng_state ^= rng_state << 13;
+            rng_state ^= rng_state >> 17;
+            rng_state ^= rng_state << 5;
+
+            return rng_state;
+        }
+
+        /**
+         * Returns a random index in [lo, hi).
+         */
+        int RandomIdx(int lo, int hi)
+        {
+            return lo + static_cast<int>(NextRandom() % static_cast<unsigned>(hi - lo));
+        }
+
+        /**
+         * Returns whichever of the three indexes holds the median of their elements.
+         */
+        static int Median3(elmtype const * arr, int a, int b, int c)
+        {
+            if (arr[a] < arr[b])
+            {
+                if (arr[b] < arr[c])
+                {
+                    return b;
+                }
+
+                return (arr[a] < arr[c]) ? c : a;
+            }
+
+            if (arr[a] < arr[c])
+            {
+                return a;
+            }
+
+            return (arr[b] < arr[c]) ? c : b;
+        }
+
+        /**
+         * Chooses a pivot from randomly sampled elements of arr[lo, hi).
+         */
+        elmtype SamplePivot(elmtype const * arr, int lo, int hi)
+        {
+            if ((hi - lo) < ninther_min)
+            {
+                return arr[Median3(arr, RandomIdx(lo, hi), RandomIdx(lo, hi), RandomIdx(lo, hi))];
+            }
+
+            // Median of the medians of three samples of three
+            int const m1 = Median3(arr, RandomIdx(lo, hi), RandomIdx(lo, hi), RandomIdx(lo, hi));
+            int const m2 = Median3(arr, RandomIdx(lo, hi), RandomIdx(lo, hi), RandomIdx(lo, hi));
+            int const m3 = Median3(arr, RandomIdx(lo, hi), RandomIdx(lo, hi), RandomIdx(lo, hi));
+
+            return arr[Median3(arr, m1, m2, m3)];
+        }
+
+        /**
+         * Chooses the median of the medians of groups of five elements of arr[lo, hi) as the pivot.
+         *
+         * @note Moves the group medians to the start of the section.
+         */
+        elmtype MedianOfMedians(elmtype * arr, int lo, int hi)
+        {
+            int groups = 0;
+
+            for (int group_start = lo; group_start < hi; group_start += 5)
+            {
+                int const group_end = min(group_start + 5, hi);
+
+                InsertionSort(arr, group_start, group_end);
+                swap(arr[lo + groups], arr[group_start + ((group_end - group_start - 1) / 2)]);
+                groups++;
+            }
+
+            int const mid = lo + ((groups - 1) / 2);
+
+            // The median of the medians is selected with median of medians pivots as well
+            SelectImpl(arr, lo, lo + groups, mid, 0);
+
+            return arr[mid];
+        }
+
+        /**
+         * Three-way partition of arr[lo, hi) around the pivot.
+         *
+         * @param[out] lt Set to the start of the elements equal to the pivot.
+         * @param[out] gt Set to the end of the elements equal to the pivot.
+         */
+        static void Partition3(elmtype * arr, int lo, int hi, elmtype const & pivot, int & lt, int & gt)
+        {
+            int i = lo;
+
+            lt = lo;
+            gt = hi;
+
+            while (i < gt)
+            {
+                if (arr[i] < pivot)
+                {
+                    swap(arr[lt++], arr[i++]);
+                }
+                else if (pivot < arr[i])
+                {
+                    swap(arr[i], arr[--gt]);
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        /**
+         * Moves the k-th smallest element of arr[lo, hi) to index k, with nothing larger before it and
+         * nothing smaller after it.
+         *
+         * @param[in] bad_splits The number of rounds that can keep more than 3/4 of the section before
+         *                       switching to median of medians pivots.
+         */
+        void SelectImpl(elmtype * arr, int lo, int hi, int k, int bad_splits)
+        {
+            while ((hi - lo) > small_section)
+            {
+                int const len = hi - lo;
+
+                elmtype const pivot = (bad_splits > 0) ? SamplePivot(arr, lo, hi) : MedianOfMedians(arr, lo, hi);
+
+                int lt;
+                int gt;
+
+                Partition3(arr, lo, hi, pivot, lt, gt);
+
+                if (k < lt)
+                {
+                    hi = lt;
+                }
+                else if (k >= gt)
+                {
+                    lo = gt;
+                }
+                else
+                {
+                    // The k-th element is equal to the pivot
+                    return;
+                }
+
+                if ((4 * (hi - lo)) > (3 * len))
+                {
+                    bad_splits--;
+                }
+            }
+
+            InsertionSort(arr, lo, hi);
+        }
+
+    public:
+
+        /**
+         * Constructor that seeds the random number generator.
+         *
+         * @param[in] seed Any value, 0 is replaced with a fixed seed.
+         */
+        IntroSelector(unsigned seed)
+        {
+            rng_state = (seed != 0) ? seed : 0x9E3779B9u;
+        }
+
+        /**
+         * Insertion sort of arr[lo, hi).
+         */
+        static void InsertionSort(elmtype * arr, int lo, int hi)
+        {
+            for (int i = lo + 1; i < hi; i++)
+            {
+                elmtype val = arr[i];
+                int     j   = i;
+
+                while ((j > lo) && (val < arr[j - 1]))
+                {
+                    arr[j] = arr[j - 1];
+                    j--;
+                }
+
+                arr[j] = val;
+            }
+        }
+
+        /**
+         * Rearranges arr[lo, hi) so that index k holds the element that would be there if the section
+         * was sorted, with nothing larger before it and nothing smaller after it.
+         */
+        void Select(elmtype * arr, int lo, int hi, int k)
+        {
+            int bad_splits = 0;
+
+            // Allow about log2(n) bad rounds before falling back to median of medians
+            for (int len = hi - lo; len > 1; len >>= 1)
+            {
+                bad_splits++;
+            }
+
+            SelectImpl(arr, lo, hi, k, bad_splits);
+        }
+
+        /**
+         * Selects several ranks at once. The middle rank is selected first, which splits the section in
+         * two, and then the ranks below it and above it are selected from their own halves only.
+         *
+         * @param[in,out] arr The array to select from.
+         * @param[in]     lo  The start of the section.
+         * @param[in]     hi  The end of the section.
+         * @param[in]     ks  The indexes to select, in increasing order with no repeats, all in [lo, hi).
+         * @param[in]     m   The number of indexes in ks.
+         */
+        void SelectMany(elmtype * arr, int lo, int hi, int const * ks, int m)
+        {
+            while (m > 0)
+            {
+                int const mid = m / 2;
+
+                Select(arr, lo, hi, ks[mid]);
+
+                // Handle the smaller side with a recursive call and loop on the larger side
+                if (mid < (m - mid - 1))
+                {
+                    SelectMany(arr, lo, ks[mid], ks, mid);
+
+                    lo  = ks[mid] + 1;
+                    ks += mid + 1;
+                    m  -= mid + 1;
+                }
+                else
+                {
+                    SelectMany(arr, ks[mid] + 1, hi, ks + mid + 1, m - mid - 1);
+
+                    hi = ks[mid];
+                    m  = mid;
+                }
+            }
+        }
+};
+
+// End of include guard for INTRO_SELECT_CPP
+#endif
@@ -0,0 +1,350 @@
+/**
+ * @file KWayMerge.cpp
+ *
+ * This file implements the k-way merge used to combine several sorted circular dynamic arrays into
+ * one.
+ *
+ * The merge uses a loser tree: each internal node of a tournament over the k runs remembers the run
+ * that lost the match played there, so after the winner's next element is taken, only the matches
+ * on the path from its leaf to the root are replayed. Each element then costs about log2 k
+ * comparisons, and every element is written once, instead of once per level of repeated pairwise
+ * merges.
+ *
+ * The parallel merge splits the output into one chunk per thread. The start of a chunk in every run
+ * is found by co-ranking: the number of elements a run has among the first p merged elements is
+ * found with a binary search on the run, counting the elements of the other runs that come before
+ * each candidate with binary searches as well.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for KWayMerge.cpp
+#ifndef K_WAY_MERGE_CPP
+#define K_WAY_MERGE_CPP
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include "SearchIndex.cpp"
+#include "ThreadPool.cpp"
+
+using namespace std;
+
+template <typename elmtype>
+struct LoserTreeMerger
+{
+    /// Merge chunks are not split below this number of elements.
+    static const int min_chunk = 4096;
+
+    /**
+     * A sorted run to merge, which may be split into two contiguous segments like a #CDA.
+     */
+    struct Run
+    {
+        const elmtype * first;      ///< The start of the first segment.
+        int             first_len;  ///< The number of elements in the first segment.
+        const elmtype * second;     ///< The start of the second segment.
+        int             second_len; ///< The number of elements in the second segment.
+    };
+
+    /**
+     * The position of the merge in one run.
+     */
+    struct Cursor
+    {
+        const elmtype * cur;      ///< The next element of the run.
+        const elmtype * end;      ///< The end of the segment being read.
+        const elmtype * next;     ///< The segment to read after this one.
+        int             next_len; ///< The number of elements in the next segment, 0 once it is used.
+
+        /**
+         * Moves to the next segment if the current one is used up.
+         */
+        void NextSegment()
+        {
+            if ((cur == end) && (next_len > 0))
+            {
+                cur      = next;
+                end      = next + next_len;
+                next_len = 0;
+            }
+        }
+    };
+
+    /**
+     * Returns the element at an index of a run.
+     */
+    static const elmtype & At(const Run & run, int idx)
+    {
+        return (idx < run.first_len) ? run.first[idx] : run.second[idx - run.first_len];
+    }
+
+    /**
+     * Returns the part [from, to) of a run.
+     */
+    static Run Slice(const Run & run, int from, int to)
+    {
+        Run slice;
+
+        if (from < run.first_len)
+        {
+            slice.first      = run.first + from;
+            slice.first_len  = min(to, run.first_len) - from;
+            slice.second     = run.second;
+            slice.second_len = max(0, to - run.first_len);
+        }
+        else
+        {
+            slice.first      = run.second + (from - run.first_len);
+            slice.first_len  = to - from;
+            slice.second     = NULL;
+            slice.second_len = 0;
+        }
+
+        return slice;
+    }
+
+    /**
+     * Returns true if the head of run a comes before the head of run b in the merge. A run that is
+     * used up comes after every other run, and ties go to the run with the lower index, so the merge
+     * is stable.
+     */
+    static bool Beats(const Cursor * cursors, int a, int b)
+    {
+        if (cursors[a].cur == cursors[a].end)
+        {
+            return false;
+        }
+        if (cursors[b].cur == cursors[b].end)
+        {
+            return true;
+        }
+
+        return (*cursors[a].cur < *cursors[b].cur) || (!(*cursors[b].cur < *cursors[a].cur) && (a < b));
+    }
+
+    /**
+     * Plays the matches of the subtree rooted at a node of the loser tree, storing each loser.
+     *
+     * @param[in]     cursors The positions of the merge in each run.
+     * @param[in]     k       The number of runs. The leaf of run i is node k + i.
+     * @param[in,out] tree    The loser of the match played at each internal node.
+     * @param[in]     node    The root of the subtree.
+     *
+     * @return The winner of the subtree.
+     */
+    static int Play(const Cursor * cursors, int k, int * tree, int node)
+    {
+        if (node >= k)
+        {
+            return node - k;
+        }
+
+        int const left  = Play(cursors, k, tree, 2 * node);
+        int const right = Play(cursors, k, tree, 2 * node + 1);
+
+        if (Beats(cursors, left, right))
+        {
+            tree[node] = right;
+            return left;
+        }
+
+        tree[node] = left;
+        return right;
+    }
+
+    /**
+     * Merges sorted runs, copying the elements into raw storage.
+     *
+     * @param[in]  runs The sorted runs. Equal elements are taken from the run with the lower index
+     *                  first.
+     * @param[in]  k    The number of runs.
+     * @param[out] out  Raw storage with room for every element of the runs, which are copy constructed
+     *                  into it in order.
+     */
+    static void Merge(const Run * runs, int k, elmtype * out)
+    {
+        if (k < 1)
+        {
+            return;
+        }
+
+        Cursor * cursors = new Cursor[k];
+        int *    tree    = new int[k];
+        int      total   = 0;
+
+        for (int idx = 0; idx < k; idx++)
+        {
+            cursors[idx].cur      = runs[idx].first;
+            cursors[idx].end      = runs[idx].first + runs[idx].first_len;
+            cursors[idx].next     = runs[idx].second;
+            cursors[idx].next_len = runs[idx].second_len;
+            cursors[idx].NextSegment();
+
+            total += runs[idx].first_len + runs[idx].second_len;
+        }
+
+        // The overall winner is kept at index 0, which isn't an internal node
+        tree[0] = Play(cursors, k, tree, 1);
+
+        for (int count = 0; count < total; count++)
+        {
+            int winner = tree[0];
+
+            ::new (static_cast<void *>(out + count)) elmtype(*cursors[winner].cur);
+
+            cursors[winner].cur++;
+            cursors[winner].NextSegment();
+
+            // Replay the matches on the path from the winner's leaf to the root
+            for (int node = (winner + k) / 2; node > 0; node /= 2)
+            {
+                if (Beats(cursors, tree[node], winner))
+                {
+                    swap(tree[node], winner);
+                }
+            }
+
+            tree[0] = winner;
+        }
+
+        delete[] cursors;
+        delete[] tree;
+    }
+
+    /**
+     * Finds how many elements each run has among the first p elements of the stable merge.
+     *
+     * @param[in]  runs  The sorted runs.
+     * @param[in]  k     The number of runs.
+     * @param[in]  p     The number of merged elements.
+     * @param[out] ranks Set to the number of elements taken from each run, which add up to p.
+     */
+    static void CoRank(const Run * runs, int k, int p, int * ranks)
+    {
+        for (int run_idx = 0; run_idx < k; run_idx++)
+        {
+            const Run & run = runs[run_idx];
+
+            int lower_bound = 0;
+            int upper_bound = run.first_len + run.second_len;
+
+            // Find the first element of the run whose place in the merge is not before p
+            while (lower_bound < upper_bound)
+            {
+                int const       mid = lower_bound + ((upper_bound - lower_bound) / 2);
+                const elmtype & e   = At(run, mid);
+
+                // Runs before this one win ties, so their equal elements come first
+                int place = mid;
+
+                for (int other = 0; (other < k) && (place < p); other++)
+                {
+                    if (other == run_idx)
+                    {
+                        continue;
+                    }
+
+                    const Run & other_run = runs[other];
+                    int const   other_len = other_run.first_len + other_run.second_len;
+
+                    if (other < run_idx)
+                    {
+                        place += BranchlessBound<true>([&other_run](int idx) -> const elmtype & { return At(other_run, idx); },
+                                                       other_len, e);
+                    }
+                    else
+                    {
+                        place += BranchlessBound<false>([&other_run](int idx) -> const elmtype & { return At(other_run, idx); },
+                                                        other_len, e);
+                    }
+                }
+
+                if (place < p)
+                {
+                    lower_bound = mid + 1;
+                }
+                else
+                {
+                    upper_bound = mid;
+                }
+            }
+
+            ranks[run_idx] = lower_bound;
+        }
+    }
+
+    /**
+     * Merges sorted runs with the pool's threads, copying the elements into raw storage.
+     *
+     * @param[in]  runs The sorted runs. Equal elements are taken from the run with the lower index
+     *                  first.
+     * @param[in]  k    The number of runs.
+     * @param[out] out  Raw storage with room for every element of the runs, which are copy constructed
+     *                  into it in order.
+     * @param[in]  pool The threads to merge with.
+     */
+    static void ParallelMerge(const Run * runs, int k, elmtype * out, ThreadPool & pool)
+    {
+        int total = 0;
+
+        for (int idx = 0; idx < k; idx++)
+        {
+            total += runs[idx].first_len + runs[idx].second_len;
+        }
+
+        int const chunks = max(1, min(pool.Size(), total / min_chunk));
+
+        if (chunks == 1)
+        {
+            Merge(runs, k, out);
+            return;
+        }
+
+        // Row c holds where chunk c starts in each run, and the last row holds the ends of the runs
+        vector<int> ranks((chunks + 1) * k, 0);
+        int *       rank_rows = ranks.data();
+
+        for (int idx = 0; idx < k; idx++)
+        {
+            rank_rows[(chunks * k) + idx] = runs[idx].first_len + runs[idx].second_len;
+        }
+
+        for (int chunk = 1; chunk < chunks; chunk++)
+        {
+            int const p = static_cast<int>((static_cast<long long>(total) * chunk) / chunks);
+
+            pool.Submit([=]()
+            {
+                CoRank(runs, k, p, rank_rows + (chunk * k));
+            });
+        }
+
+        pool.Wait();
+
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            int const p = static_cast<int>((static_cast<long long>(total) * chunk) / chunks);
+
+            pool.Submit([=]()
+            {
+                Run * slices = new Run[k];
+
+                for (int idx = 0; idx < k; idx++)
+                {
+                    slices[idx] = Slice(runs[idx], rank_rows[(chunk * k) + idx], rank_rows[((chunk + 1) * k) + idx]);
+                }
+
+                Merge(slices, k, out + p);
+
+                delete[] slices;
+            });
+        }
+
+        pool.Wait();
+    }
+};
+
+// End of include guard for K_WAY_MERGE_CPP
+#endif
@@ -0,0 +1,428 @@
+/**
+ * @file MergeSort.cpp
+ *
+ * This file implements the bottom-up merge sort used by the circular dynamic array.
+ *
+ * The array is first split into runs that are already in order (descending runs are reversed), and
+ * short runs are extended with an insertion sort. Neighbouring runs are then merged pass by pass,
+ * alternating between the array and one scratch array, so the sort makes no recursive calls. The
+ * only memory the sort allocates itself is the list of run boundaries, one int per run. When one run
+ * keeps winning during a merge, the merge gallops ahead with an exponential search instead of
+ * comparing one element at a time. Elements are only ever moved between the two arrays, never
+ * copied, so each pass is cheap even for elements that own memory.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for MergeSort.cpp
+#ifndef MERGE_SORT_CPP
+#define MERGE_SORT_CPP
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+template <typename elmtype>
+struct BottomUpMergeSorter
+{
+    static const int min_run    = 32; ///< Runs shorter than this are extended with an insertion sort.
+    static const int min_gallop = 7;  ///< Number of wins in a row before a merge starts galloping.
+
+    /**
+     * Moves elements into new raw storage, to be used as the scratch array of a sort. The originals
+     * are left moved from, so they can be used as the other buffer of the sort, and no element is
+     * ever default constructed.
+     *
+     * @param[in] src The elements to move.
+     * @param[in] n   The number of elements to move.
+     *
+     * @return The scratch array, which must be freed with #FreeScratch().
+     */
+    static elmtype * MoveToScratch(elmtype * src, int n)
+    {
+        elmtype * scratch = static_cast<elmtype *>(::operator new(n * sizeof(elmtype)));
+
+        uninitialized_copy(make_move_iterator(src), make_move_iterator(src + n), scratch);
+
+        return scratch;
+    }
+
+    /**
+     * Destroys the elements of a scratch array made by #MoveToScratch() and frees it.
+     *
+     * @param[in] scratch The scratch array.
+     * @param[in] n       The number of elements in it.
+     */
+    static void FreeScratch(elmtype * scratch, int n)
+    {
+        if (!is_trivially_destructible<elmtype>::value)
+        {
+            for (int idx = 0; idx < n; idx++)
+            {
+                scratch[idx].~elmtype();
+            }
+        }
+
+        ::operator delete(static_cast<void *>(scratch));
+    }
+
+    /**
+     * Moves an element into a slot of the destination of a merge.
+     *
+     * @tparam b_construct True if the slot is raw storage, so the element is move constructed into it,
+     *                     false if it holds an element, which is move assigned to.
+     */
+    template <bool b_construct>
+    static void Put(elmtype * slot, elmtype & val)
+    {
+        if (b_construct)
+        {
+            ::new (static_cast<void *>(slot)) elmtype(move(val));
+        }
+        else
+        {
+            *slot = move(val);
+        }
+    }
+
+    /**
+     * Moves the elements of [first, last) into dest, like #Put().
+     */
+    template <bool b_construct>
+    static void PutRange(elmtype * first, elmtype * last, elmtype * dest)
+    {
+        if (b_construct)
+        {
+            uninitialized_copy(make_move_iterator(first), make_move_iterator(last), dest);
+        }
+        else
+        {
+            move(first, last, dest);
+        }
+    }
+
+    /**
+     * Insertion sort of arr[start, end), where arr[start, sorted_end) is already sorted.
+     */
+    static void InsertionSort(elmtype * arr, int start, int sorted_end, int end)
+    {
+        for (int i = sorted_end; i < end; i++)
+        {
+            elmtype val = move(arr[i]);
+            int     j   = i;
+
+            // Shift larger elements up, stopping at equal ones so the sort stays stable
+            while ((j > start) && (val < arr[j - 1]))
+            {
+                arr[j] = move(arr[j - 1]);
+                j--;
+            }
+
+            arr[j] = move(val);
+        }
+    }
+
+    /**
+     * Finds the end of the run that starts at start. A strictly descending run is reversed so that
+     * every run is in ascending order.
+     *
+     * @return The index just past the end of the run.
+     */
+    static int RunEnd(elmtype * arr, int start, int n)
+    {
+        int end = start + 1;
+
+        if (end >= n)
+        {
+            return n;
+        }
+
+        if (arr[end] < arr[start])
+        {
+            // Only strictly descending runs are reversed, otherwise equal elements would swap order
+            while ((end < n) && (arr[end] < arr[end - 1]))
+            {
+                end++;
+            }
+
+            reverse(arr + start, arr + end);
+        }
+        else
+        {
+            while ((end < n) && !(arr[end] < arr[end - 1]))
+            {
+                end++;
+            }
+        }
+
+        return end;
+    }
+
+    /**
+     * Counts the leading elements of a sorted array that are less than or equal to key.
+     */
+    static int GallopRight(elmtype const & key, elmtype const * arr, int len)
+    {
+        int lower_bound = 0;
+        int step        = 1;
+
+        // Skip ahead in growing steps while the elements are still less than or equal to the key
+        while (((lower_bound + step) <= len) && !(key < arr[lower_bound + step - 1]))
+        {
+            lower_bound += step;
+            step        *= 2;
+        }
+
+        int upper_bound = min(len, lower_bound + step);
+
+        while (lower_bound < upper_bound)
+        {
+            int const mid = lower_bound + ((upper_bound - lower_bound) / 2);
+
+            if (!(key < arr[mid]))
+            {
+                lower_bound = mid + 1;
+            }
+            else
+            {
+                upper_bound = mid;
+            }
+        }
+
+        return lower_bound;
+    }
+
+    /**
+     * Counts the leading elements of a sorted array that are strictly less than key.
+     */
+    static int GallopLeft(elmtype const & key, elmtype const * arr, int len)
+    {
+        int lower_bound = 0;
+        int step        = 1;
+
+        // Skip ahead in growing steps while the elements are still less than the key
+        while (((lower_bound + step) <= len) && (arr[lower_bound + step - 1] < key))
+        {
+            lower_bound += step;
+            step        *= 2;
+        }
+
+        int upper_bound = min(len, lower_bound + step);
+
+        while (lower_bound < upper_bound)
+        {
+            int const mid = lower_bound + ((upper_bound - lower_bound) / 2);
+
+            if (arr[mid] < key)
+            {
+                lower_bound = mid + 1;
+            }
+            else
+            {
+                upper_bound = mid;
+            }
+        }
+
+        return lower_bound;
+    }
+
+    /**
+     * Stable merge of two sorted arrays. Equal elements are taken from a first.
+     *
+     * @param[in,out] a     The first sorted array, whose elements are left moved from.
+     * @param[in]     a_len The number of elements in a.
+     * @param[in,out] b     The second sorted array, whose elements are left moved from.
+     * @param[in]     b_len The number of elements in b.
+     * @param[out]    dest  The array to move the elements into, which must not overlap a or b.
+     *
+     * @tparam b_construct True if dest is raw storage, which the elements are move constructed into.
+     */
+    template <bool b_construct = false>
+    static void Merge(elmtype * a, int a_len, elmtype * b, int b_len, elmtype * dest)
+    {
+        // If the two arrays are already in order, there is nothing to compare
+        if ((a_len == 0) || (b_len == 0) || !(b[0] < a[a_len - 1]))
+        {
+            PutRange<b_construct>(a, a + a_len, dest);
+            PutRange<b_construct>(b, b + b_len, dest + a_len);
+            return;
+        }
+
+        int i      = 0; ///< Index of the next element of a
+        int j      = 0; ///< Index of the next element of b
+        int k      = 0; ///< Index of the next element of dest
+        int a_wins = 0; ///< Number of elements in a row taken from a
+        int b_wins = 0; ///< Number of elements in a row taken from b
+
+        while ((i < a_len) && (j < b_len))
+        {
+            if (b[j] < a[i])
+            {
+                Put<b_construct>(dest + k++, b[j++]);
+                b_wins++;
+                a_wins = 0;
+            }
+            else
+            {
+                Put<b_construct>(dest + k++, a[i++]);
+                a_wins++;
+                b_wins = 0;
+            }
+
+            if (a_wins >= min_gallop)
+            {
+                // Move every element of a that comes before b[j] at once
+                int const count = GallopRight(b[j], a + i, a_len - i);
+
+                PutRange<b_construct>(a + i, a + i + count, dest + k);
+                i += count;
+                k += count;
+                a_wins = 0;
+            }
+            else if (b_wins >= min_gallop)
+            {
+                // Move every element of b that comes before a[i] at once
+                int const count = GallopLeft(a[i], b + j, b_len - j);
+
+                PutRange<b_construct>(b + j, b + j + count, dest + k);
+                j += count;
+                k += count;
+                b_wins = 0;
+            }
+        }
+
+        PutRange<b_construct>(a + i, a + a_len, dest + k);
+        PutRange<b_construct>(b + j, b + b_len, dest + k + (a_len - i));
+    }
+
+    /**
+     * Sorts an array.
+     *
+     * @param[in,out] data          The array to sort.
+     * @param[in]     scratch       A scratch array with room for n elements.
+     * @param[in]     n             The number of elements in the array.
+     * @param[in,out] p_scratch_raw If not NULL, set to true on entry if the scratch array is raw
+     *                              storage. The first merge pass then move constructs the elements
+     *                              into it, and it is set to false once that has happened.
+     *
+     * @return Either data or scratch, whichever one holds the sorted elements.
+     */
+    static elmtype * Sort(elmtype * data, elmtype * scratch, int n, bool * p_scratch_raw = NULL)
+    {
+        // The boundaries of each run, run r is [bounds[r], bounds[r + 1])
+        vector<int> bounds;
+        bounds.push_back(0);
+
+        // Split the array into ascending runs that are at least min_run long
+        for (int start = 0; start < n; )
+        {
+            int end = RunEnd(data, start, n);
+
+            if ((end - start) < min_run)
+            {
+                int const forced_end = min(n, start + min_run);
+
+                InsertionSort(data, start, end, forced_end);
+                end = forced_end;
+            }
+
+            bounds.push_back(end);
+            start = end;
+        }
+
+        elmtype * src        = data;
+        elmtype * dest       = scratch;
+        bool      b_dest_raw = (p_scratch_raw != NULL) && *p_scratch_raw;
+
+        // Merge pairs of neighbouring runs until only one is left
+        while (bounds.size() > 2)
+        {
+            size_t merged = 1;
+
+            for (size_t run = 0; (run + 1) < bounds.size(); run += 2)
+            {
+                elmtype * const run_dest = dest + bounds[run];
+
+                if ((run + 2) < bounds.size())
+                {
+                    int const a_len = bounds[run + 1] - bounds[run];
+                    int const b_len = bounds[run + 2] - bounds[run + 1];
+
+                    if (b_dest_raw)
+                    {
+                        Merge<true>(src + bounds[run], a_len, src + bounds[run + 1], b_len, run_dest);
+                    }
+                    else
+                    {
+                        Merge<false>(src + bounds[run], a_len, src + bounds[run + 1], b_len, run_dest);
+                    }
+
+                    bounds[merged++] = bounds[run + 2];
+                }
+                else
+                {
+                    // The last run has no partner, so it is just moved over
+                    if (b_dest_raw)
+                    {
+                        PutRange<true>(src + bounds[run], src + bounds[run + 1], run_dest);
+                    }
+                    else
+                    {
+                        PutRange<false>(src + bounds[run], src + bounds[run + 1], run_dest);
+                    }
+
+                    bounds[merged++] = bounds[run + 1];
+                }
+            }
+
+            // Every slot of the destination has now been filled
+            b_dest_raw = false;
+
+            bounds.resize(merged);
+            swap(src, dest);
+        }
+
+        if (p_scratch_raw != NULL)
+        {
+            *p_scratch_raw = b_dest_raw;
+        }
+
+        return src;
+    }
+
+    /**
+     * Sorts an array, leaving the sorted elements in it. The scratch array is raw storage that the
+     * first merge pass moves the elements into, so the elements aren't moved anywhere before the sort
+     * starts and no element is ever default constructed.
+     *
+     * @param[in,out] data The array to sort.
+     * @param[in]     n    The number of elements in the array.
+     */
+    static void SortInPlace(elmtype * data, int n)
+    {
+        elmtype * scratch       = static_cast<elmtype *>(::operator new(n * sizeof(elmtype)));
+        bool      b_scratch_raw = true;
+
+        if (Sort(data, scratch, n, &b_scratch_raw) == scratch)
+        {
+            move(scratch, scratch + n, data);
+        }
+
+        if (b_scratch_raw)
+        {
+            ::operator delete(static_cast<void *>(scratch));
+        }
+        else
+        {
+            FreeScratch(scratch, n);
+        }
+    }
+};
+
+// End of include guard for MERGE_SORT_CPP
+#endif
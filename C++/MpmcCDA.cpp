@@ -0,0 +1,499 @@
+/**
+ * @file MpmcCDA.cpp
+ *
+ * This file implements a fixed capacity version of the circular dynamic array that any number of
+ * producer and consumer threads can use as a FIFO without any locks.
+ *
+ * Every slot has a sequence number that says whose turn it is to use the slot. A producer claims the
+ * slot for back index i once its sequence number is i, writes the element, and sets the sequence
+ * number to i + 1. A consumer claims the slot for front index i once its sequence number is i + 1,
+ * takes the element, and sets the sequence number to i + #arr_capacity, which is the back index the
+ * slot will be used for next. Threads claim an index with a compare and swap on #back_idx or
+ * #front_idx, so they only ever contend on the index, never on a lock.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for MpmcCDA.cpp
+#ifndef MPMC_CDA_CPP
+#define MPMC_CDA_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Waits used by the blocking functions of the #MpmcCDA while the array is full or empty. The first
+ * waits spin for a growing number of iterations, and once they get long enough the thread yields
+ * instead.
+ */
+class Backoff
+{
+    private:
+
+        static const int max_spins = 1024; ///< The longest spin before the thread starts yielding.
+
+        int spins = 1; ///< The number of iterations the next wait spins for.
+
+    public:
+
+        /**
+         * Waits for a little longer than the previous call.
+         */
+        void Wait()
+        {
+            if (spins <= max_spins)
+            {
+                for (volatile int spin = 0; spin < spins; spin++)
+                {
+                }
+
+                spins *= 2;
+            }
+            else
+            {
+                this_thread::yield();
+            }
+        }
+};
+
+template <typename elmtype>
+
+class MpmcCDA
+{
+    private:
+
+        static const int cache_line = 64; ///< The size of a cache line in bytes.
+
+        /**
+         * A slot of the array, and the sequence number that says whose turn it is to use it.
+         */
+        struct Cell
+        {
+            atomic<unsigned> sequence;                                          ///< Whose turn it is to use the slot.
+            typename aligned_storage<sizeof(elmtype), alignof(elmtype)>::type storage; ///< Raw storage for the element.
+
+            elmtype * Elm()
+            {
+                return reinterpret_cast<elmtype *>(&storage);
+            }
+        };
+
+        // Set once by the constructor, and only read after that.
+        Cell *         cells = NULL;  ///< The slots of the array.
+        unsigned const arr_capacity;  ///< The capacity of the array, always a power of two.
+        unsigned const idx_mask;      ///< Mask that wraps an index into the #cells.
+
+        alignas(cache_line) atomic<unsigned> back_idx;  ///< The next back index to be claimed by a producer.
+        alignas(cache_line) atomic<unsigned> front_idx; ///< The next front index to be claimed by a consumer.
+
+        /**
+         * Rounds a capacity up to the next power of two, with a minimum of 2.
+         */
+        static unsigned RoundCapacity(int s)
+        {
+            unsigned capacity = 2;
+
+            while (capacity < static_cast<unsigned>(max(2, s)))
+            {
+                capacity <<= 1;
+            }
+
+            return capacity;
+        }
+
+        /**
+         * Claims up to n consecutive back indexes whose slots are free.
+         *
+         * @param[in]  n     The largest number of indexes to claim.
+         * @param[out] start Set to the first claimed index.
+         *
+         * @return The number of indexes claimed, 0 if the array is full.
+         */
+        unsigned ClaimBack(unsigned n, unsigned & start)
+        {
+            unsigned pos = back_idx.load(memory_order_relaxed);
+
+            while (true)
+            {
+                // Count the free slots from pos onwards
+                unsigned count = 0;
+
+                while ((count < n) &&
+                       (cells[(pos + count) & idx_mask].sequence.load(memory_order_acquire) == (pos + count)))
+                {
+                    count++;
+                }
+
+                if (count == 0)
+                {
+                    int const dif = static_cast<int>(cells[pos & idx_mask].sequence.load(memory_order_acquire) - pos);
+
+                    // A slot behind pos means the array is full, otherwise another producer got here first
+                    if (dif < 0)
+                    {
+                        return 0;
+                    }
+
+                    pos = back_idx.load(memory_order_relaxed);
+                }
+                else if (back_idx.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                {
+                    start = pos;
+
+                    return count;
+                }
+            }
+        }
+
+        /**
+         * Claims up to n consecutive front indexes whose slots hold elements.
+         *
+         * @param[in]  n     The largest number of indexes to claim.
+         * @param[out] start Set to the first claimed index.
+         *
+         * @return The number of indexes claimed, 0 if the array is empty.
+         */
+        unsigned ClaimFront(unsigned n, unsigned & start)
+        {
+            unsigned pos = front_idx.load(memory_order_relaxed);
+
+            while (true)
+            {
+                // Count the filled slots from pos onwards
+                unsigned count = 0;
+
+                while ((count < n) &&
+                       (cells[(pos + count) & idx_mask].sequence.load(memory_order_acquire) == (pos + count + 1)))
+                {
+                    count++;
+                }
+
+                if (count == 0)
+                {
+                    int const dif = static_cast<int>(cells[pos & idx_mask].sequence.load(memory_order_acquire) - (pos + 1));
+
+                    // A slot behind pos means the array is empty, otherwise another consumer got here first
+                    if (dif < 0)
+                    {
+                        return 0;
+                    }
+
+                    pos = front_idx.load(memory_order_relaxed);
+                }
+                else if (front_idx.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                {
+                    start = pos;
+
+                    return count;
+                }
+            }
+        }
+
+        /**
+         * Moves the element out of a claimed front slot, and hands the slot back to the producers.
+         */
+        void TakeElm(unsigned pos, elmtype & out)
+        {
+            Cell & cell = cells[pos & idx_mask];
+
+            out = move(*cell.Elm());
+            cell.Elm()->~elmtype();
+
+            cell.sequence.store(pos + arr_capacity, memory_order_release);
+        }
+
+    public:
+
+        /**
+         * Constructor that creates an empty array with room for at least s elements.
+         *
+         * @param[in] s The number of elements the array needs room for, rounded up to the next power of
+         *              two.
+         */
+        MpmcCDA(int s) : arr_capacity(RoundCapacity(s)), idx_mask(RoundCapacity(s) - 1),
+                         back_idx(0), front_idx(0)
+        {
+            cells = new Cell[arr_capacity];
+
+            // Every slot starts out waiting for the producer of its first back index
+            for (unsigned idx = 0; idx < arr_capacity; idx++)
+            {
+                cells[idx].sequence.store(idx, memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Destructor, which destroys any elements that were never deleted.
+         *
+         * @note No thread can be using the array any more.
+         */
+        ~MpmcCDA()
+        {
+            unsigned const back = back_idx.load(memory_order_acquire);
+
+            for (unsigned idx = front_idx.load(memory_order_acquire); idx != back; idx++)
+            {
+                cells[idx & idx_mask].Elm()->~elmtype();
+            }
+
+            delete[] cells;
+        }
+
+        MpmcCDA(const MpmcCDA &) = delete;
+        MpmcCDA& operator=(const MpmcCDA &) = delete;
+
+        /**
+         * Returns the number of elements in the array. If other threads are using the array, the size
+         * may have changed by the time it is returned.
+         *
+         * @return The number of elements in the array.
+         */
+        int Length()
+        {
+            unsigned const front = front_idx.load(memory_order_acquire);
+            unsigned const back  = back_idx.load(memory_order_acquire);
+
+            return max(0, static_cast<int>(back - front));
+        }
+
+        /**
+         * Returns the capacity of the array.
+         *
+         * @return The number of elements the array has room for.
+         */
+        int Capacity()
+        {
+            return static_cast<int>(arr_capacity);
+        }
+
+        /**
+         * Constructs an element from the given arguments at the back of the array, if there is room.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        template <typename... arg_types>
+        bool TryEmplaceEnd(arg_types &&... args)
+        {
+            unsigned pos;
+
+            if (ClaimBack(1, pos) == 0)
+            {
+                return false;
+            }
+
+            Cell & cell = cells[pos & idx_mask];
+
+            ::new (static_cast<void *>(cell.Elm())) elmtype(forward<arg_types>(args)...);
+
+            // Hand the slot to the consumer of this index
+            cell.sequence.store(pos + 1, memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * Adds an element to the back of the array, if there is room.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        bool TryAddEnd(const elmtype & data_val)
+        {
+            return TryEmplaceEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the array, if there is room.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array. It is left
+         *                     unchanged if the array was full.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        bool TryAddEnd(elmtype && data_val)
+        {
+            return TryEmplaceEnd(move(data_val));
+        }
+
+        /**
+         * Moves the front element of the array out and deletes it, if there is one.
+         *
+         * @param[out] out Set to the front element.
+         *
+         * @retval true  An element was deleted.
+         * @retval false The array was empty, so out was not changed.
+         */
+        bool TryDelFront(elmtype & out)
+        {
+            unsigned pos;
+
+            if (ClaimFront(1, pos) == 0)
+            {
+                return false;
+            }
+
+            TakeElm(pos, out);
+
+            return true;
+        }
+
+        /**
+         * Adds an element to the back of the array, waiting for room if the array is full.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         */
+        void AddEnd(const elmtype & data_val)
+        {
+            Backoff backoff;
+
+            while (!TryAddEnd(data_val))
+            {
+                backoff.Wait();
+            }
+        }
+
+        /**
+         * Moves an element to the back of the array, waiting for room if the array is full.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array.
+         */
+        void AddEnd(elmtype && data_val)
+        {
+            Backoff backoff;
+
+            while (!TryAddEnd(move(data_val)))
+            {
+                backoff.Wait();
+            }
+        }
+
+        /**
+         * Moves the front element of the array out and deletes it, waiting for an element if the
+         * array is empty.
+         *
+         * @param[out] out Set to the front element.
+         */
+        void DelFront(elmtype & out)
+        {
+            Backoff backoff;
+
+            while (!TryDelFront(out))
+            {
+                backoff.Wait();
+            }
+        }
+
+        /**
+         * Adds as many elements of a range as there is room for to the back of the array. The added
+         * elements are given consecutive indexes, so they stay together and in order.
+         *
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
+         *
+         * @return The number of elements that were added, starting with src[0].
+         */
+        int TryAppendRange(const elmtype * src, int n)
+        {
+            unsigned pos;
+            unsigned const count = (n > 0) ? ClaimBack(static_cast<unsigned>(n), pos) : 0;
+
+            for (unsigned idx = 0; idx < count; idx++)
+            {
+                Cell & cell = cells[(pos + idx) & idx_mask];
+
+                ::new (static_cast<void *>(cell.Elm())) elmtype(src[idx]);
+                cell.sequence.store(pos + idx + 1, memory_order_release);
+            }
+
+            return static_cast<int>(count);
+        }
+
+        /**
+         * Moves up to n elements out of the front of the array and deletes them. The deleted elements
+         * have consecutive indexes, so they are in the order they were added.
+         *
+         * @param[out] out The array to move the elements to, which must have room for n elements.
+         * @param[in]  n   The largest number of elements to delete.
+         *
+         * @return The number of elements that were deleted.
+         */
+        int TryDelFrontRange(elmtype * out, int n)
+        {
+            unsigned pos;
+            unsigned const count = (n > 0) ? ClaimFront(static_cast<unsigned>(n), pos) : 0;
+
+            for (unsigned idx = 0; idx < count; idx++)
+            {
+                TakeElm(pos + idx, out[idx]);
+            }
+
+            return static_cast<int>(count);
+        }
+
+        /**
+         * Adds every element of a range to the back of the array, waiting for room whenever the array
+         * is full.
+         *
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
+         *
+         * @note Other producers may add elements between the blocks that are added by this call.
+         */
+        void AppendRange(const elmtype * src, int n)
+        {
+            Backoff backoff;
+
+            while (n > 0)
+            {
+                int const count = TryAppendRange(src, n);
+
+                if (count == 0)
+                {
+                    backoff.Wait();
+                }
+
+                src += count;
+                n   -= count;
+            }
+        }
+
+        /**
+         * Moves n elements out of the front of the array and deletes them, waiting for elements
+         * whenever the array is empty.
+         *
+         * @param[out] out The array to move the elements to, which must have room for n elements.
+         * @param[in]  n   The number of elements to delete.
+         */
+        void DelFrontRange(elmtype * out, int n)
+        {
+            Backoff backoff;
+
+            while (n > 0)
+            {
+                int const count = TryDelFrontRange(out, n);
+
+                if (count == 0)
+                {
+                    backoff.Wait();
+                }
+
+                out += count;
+                n   -= count;
+            }
+        }
+};
+
+// End of include guard for MPMC_CDA_CPP
+#endif
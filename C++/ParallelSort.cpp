@@ -0,0 +1,181 @@
+/**
+ * @file ParallelSort.cpp
+ *
+ * This file implements the parallel stable merge sort used by the circular dynamic array.
+ *
+ * The array is split into one run per thread and the runs are sorted concurrently. Pairs of runs are
+ * then merged until one run is left. Each merge is split into chunks of the output, and the start of
+ * each chunk in both inputs is found with a binary search (co-ranking), so every chunk can be merged
+ * by a different thread.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for ParallelSort.cpp
+#ifndef PARALLEL_SORT_CPP
+#define PARALLEL_SORT_CPP
+
+#include <algorithm>
+#include <vector>
+
+#include "MergeSort.cpp"
+#include "ThreadPool.cpp"
+
+using namespace std;
+
+template <typename elmtype>
+struct ParallelMergeSorter
+{
+    /// Runs and merge chunks are not split below this number of elements.
+    static const int min_chunk = 4096;
+
+    /**
+     * Finds how many elements of a are among the first k elements of the stable merge of a and b.
+     *
+     * @param[in] k     The number of merged elements.
+     * @param[in] a     The first sorted array, which wins ties.
+     * @param[in] a_len The number of elements in a.
+     * @param[in] b     The second sorted array.
+     * @param[in] b_len The number of elements in b.
+     *
+     * @return The number of elements taken from a. The rest, k minus that, are taken from b.
+     */
+    static int CoRank(int k, elmtype const * a, int a_len, elmtype const * b, int b_len)
+    {
+        int lower_bound = max(0, k - b_len);
+        int upper_bound = min(k, a_len);
+
+        while (lower_bound < upper_bound)
+        {
+            int const i = lower_bound + ((upper_bound - lower_bound) / 2);
+
+            // If a[i] is not after b[k - i - 1], it must be taken before it, so i is too small.
+            if (!(b[k - i - 1] < a[i]))
+            {
+                lower_bound = i + 1;
+            }
+            else
+            {
+                upper_bound = i;
+            }
+        }
+
+        return lower_bound;
+    }
+
+    /**
+     * Merges two sorted arrays by splitting the output into chunks that are merged by the pool.
+     *
+     * @note Submits the tasks but doesn't wait for them to finish.
+     */
+    static void ParallelMerge(elmtype * a, int a_len, elmtype * b, int b_len,
+                              elmtype * dest, int chunks, ThreadPool & pool)
+    {
+        int const n = a_len + b_len;
+
+        chunks = max(1, min(chunks, n / min_chunk));
+
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            int const k_start = static_cast<int>((static_cast<long long>(n) * chunk) / chunks);
+            int const k_end   = static_cast<int>((static_cast<long long>(n) * (chunk + 1)) / chunks);
+            int const i_start = CoRank(k_start, a, a_len, b, b_len);
+            int const i_end   = CoRank(k_end, a, a_len, b, b_len);
+
+            pool.Submit([=]()
+            {
+                BottomUpMergeSorter<elmtype>::Merge(a + i_start, i_end - i_start,
+                                                    b + (k_start - i_start),
+                                                    (k_end - i_end) - (k_start - i_start),
+                                                    dest + k_start);
+            });
+        }
+    }
+
+    /**
+     * Sorts an array with the pool's threads.
+     *
+     * @param[in,out] data    The array to sort.
+     * @param[in]     scratch A scratch array with room for n elements.
+     * @param[in]     n       The number of elements in the array.
+     * @param[in]     pool    The threads to sort with.
+     *
+     * @return Either data or scratch, whichever one holds the sorted elements.
+     */
+    static elmtype * Sort(elmtype * data, elmtype * scratch, int n, ThreadPool & pool)
+    {
+        int const threads = pool.Size();
+        int const runs    = max(1, min(threads, n / min_chunk));
+
+        // The boundaries of each run, run r is [bounds[r], bounds[r + 1])
+        vector<int> bounds;
+
+        for (int run = 0; run <= runs; run++)
+        {
+            bounds.push_back(static_cast<int>((static_cast<long long>(n) * run) / runs));
+        }
+
+        // Sort every run concurrently, each using its own section of the scratch array
+        for (int run = 0; run < runs; run++)
+        {
+            elmtype * const run_data    = data + bounds[run];
+            elmtype * const run_scratch = scratch + bounds[run];
+            int const       run_len     = bounds[run + 1] - bounds[run];
+
+            pool.Submit([=]()
+            {
+                elmtype * sorted = BottomUpMergeSorter<elmtype>::Sort(run_data, run_scratch, run_len);
+
+                if (sorted == run_scratch)
+                {
+                    move(run_scratch, run_scratch + run_len, run_data);
+                }
+            });
+        }
+
+        pool.Wait();
+
+        elmtype * src  = data;
+        elmtype * dest = scratch;
+
+        // Merge pairs of neighbouring runs until only one is left
+        while (bounds.size() > 2)
+        {
+            vector<int> merged_bounds;
+
+            for (size_t run = 0; (run + 1) < bounds.size(); run += 2)
+            {
+                merged_bounds.push_back(bounds[run]);
+
+                if ((run + 2) < bounds.size())
+                {
+                    int const a_len = bounds[run + 1] - bounds[run];
+                    int const b_len = bounds[run + 2] - bounds[run + 1];
+
+                    // Give each merge a share of the threads that matches its share of the elements
+                    int const chunks = static_cast<int>((static_cast<long long>(threads) * (a_len + b_len)) / n) + 1;
+
+                    ParallelMerge(src + bounds[run], a_len, src + bounds[run + 1], b_len,
+                                  dest + bounds[run], chunks, pool);
+                }
+                else
+                {
+                    // The last run has no partner, so it is just moved over
+                    move(src + bounds[run], src + bounds[run + 1], dest + bounds[run]);
+                }
+            }
+
+            merged_bounds.push_back(n);
+
+            pool.Wait();
+
+            bounds = merged_bounds;
+            swap(src, dest);
+        }
+
+        return src;
+    }
+};
+
+// End of include guard for PARALLEL_SORT_CPP
+#endif
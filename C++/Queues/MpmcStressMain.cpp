@@ -0,0 +1,194 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "MpmcCDA.cpp"
+
+// The capacity of the queue, kept small so the indexes wrap around often
+const int queue_capacity = 16;
+
+// The number of producer and consumer threads
+const int producers = 4;
+const int consumers = 4;
+
+// The item for a producer's sequence number. It is long enough to live on the heap, so the sanitizer
+// sees every read and write of its contents.
+string make_item(int producer, long seq)
+{
+	return "mpmc stress item " + to_string(producer) + " " + to_string(seq);
+}
+
+// Reads the producer and sequence number back out of an item
+void parse_item(const string & item, int & producer, long & seq)
+{
+	size_t const space = item.find(' ', 17);
+
+	producer = atoi(item.c_str() + 17);
+	seq      = atol(item.c_str() + space + 1);
+}
+
+// Adds count items in order, switching between single, bulk, blocking and non-blocking adds
+void produce(MpmcCDA<string> & queue, int producer, long count)
+{
+	vector<string> buf;
+
+	for (long seq = 0; seq < count; )
+	{
+		int const mode = static_cast<int>((seq + producer) % 4);
+		long const n   = min(5L, count - seq);
+
+		buf.clear();
+
+		for (long idx = seq; idx < seq + n; idx++)
+		{
+			buf.push_back(make_item(producer, idx));
+		}
+
+		if (mode == 0)
+		{
+			queue.AddEnd(buf[0]);
+			seq++;
+		}
+		else if (mode == 1)
+		{
+			if (queue.TryAddEnd(move(buf[0])))
+			{
+				seq++;
+			}
+		}
+		else if (mode == 2)
+		{
+			queue.AppendRange(buf.data(), static_cast<int>(n));
+			seq += n;
+		}
+		else
+		{
+			seq += queue.TryAppendRange(buf.data(), static_cast<int>(n));
+		}
+
+		this_thread::yield();
+	}
+}
+
+// Deletes count items, switching between single, bulk, blocking and non-blocking deletes. Each item
+// must be seen exactly once, and the items of each producer must come out in order.
+bool consume(MpmcCDA<string> & queue, int consumer, long count, vector<atomic<int> > & seen, long per_producer)
+{
+	string buf[6];
+	long   last_seq[producers];
+	bool   b_ok = true;
+
+	for (int producer = 0; producer < producers; producer++)
+	{
+		last_seq[producer] = -1;
+	}
+
+	for (long taken_total = 0; taken_total < count; )
+	{
+		int const mode = static_cast<int>((taken_total + consumer) % 4);
+		int const n    = static_cast<int>(min(6L, count - taken_total));
+		int taken      = 0;
+
+		if (mode == 0)
+		{
+			queue.DelFront(buf[0]);
+			taken = 1;
+		}
+		else if (mode == 1)
+		{
+			taken = queue.TryDelFront(buf[0]) ? 1 : 0;
+		}
+		else if (mode == 2)
+		{
+			queue.DelFrontRange(buf, n);
+			taken = n;
+		}
+		else
+		{
+			taken = queue.TryDelFrontRange(buf, n);
+		}
+
+		for (int idx = 0; idx < taken; idx++)
+		{
+			int  producer;
+			long seq;
+
+			parse_item(buf[idx], producer, seq);
+
+			b_ok = b_ok && (producer >= 0) && (producer < producers) && (seq > last_seq[producer]) &&
+			       (buf[idx] == make_item(producer, seq));
+
+			if (b_ok)
+			{
+				last_seq[producer] = seq;
+				seen[producer * per_producer + seq]++;
+			}
+		}
+
+		taken_total += taken;
+
+		if (taken == 0)
+		{
+			this_thread::yield();
+		}
+	}
+
+	return b_ok;
+}
+
+int main(int argc, char * argv[]) {
+
+	// The number of items each producer sends, which can be given as the first argument
+	long const per_producer = (argc > 1) ? atol(argv[1]) : 20000;
+	long const total        = per_producer * producers;
+
+	MpmcCDA<string>     queue(queue_capacity);
+	vector<atomic<int> > seen(total);
+	atomic<int>         failed(0);
+	vector<thread>      workers;
+
+	for (long idx = 0; idx < total; idx++)
+	{
+		seen[idx] = 0;
+	}
+
+	for (int idx = 0; idx < producers; idx++)
+	{
+		workers.push_back(thread(produce, ref(queue), idx, per_producer));
+	}
+
+	for (int idx = 0; idx < consumers; idx++)
+	{
+		// Each consumer takes an equal share, so the blocking deletes always finish
+		long const share = (total / consumers) + ((idx < (total % consumers)) ? 1 : 0);
+
+		workers.push_back(thread([&, idx, share]()
+		{
+			if (!consume(queue, idx, share, seen, per_producer))
+			{
+				failed++;
+			}
+		}));
+	}
+
+	for (size_t idx = 0; idx < workers.size(); idx++)
+	{
+		workers[idx].join();
+	}
+
+	bool b_ok = (failed == 0) && (queue.Length() == 0);
+
+	for (long idx = 0; b_ok && (idx < total); idx++)
+	{
+		b_ok = (seen[idx] == 1);
+	}
+
+	cout << "MpmcCDA stress: " << total << " items " << (b_ok ? "passed" : "FAILED") << endl;
+
+	return b_ok ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "CDA.cpp"
+#include "MpmcCDA.cpp"
+
+// The capacity of every queue in the benchmark
+const int queue_capacity = 4096;
+
+// A CDA protected by a mutex, which is what the lock-free queue replaces
+class LockedCDA
+{
+	private:
+
+		CDA<long> arr;
+		mutex     arr_mutex;
+
+	public:
+
+		LockedCDA() : arr(0)
+		{
+		}
+
+		int TryAppendRange(const long * src, int n)
+		{
+			unique_lock<mutex> lock(arr_mutex);
+
+			n = min(n, queue_capacity - arr.Length());
+			arr.AppendRange(src, n);
+
+			return n;
+		}
+
+		int TryDelFrontRange(long * out, int n)
+		{
+			unique_lock<mutex> lock(arr_mutex);
+
+			n = min(n, arr.Length());
+
+			for (int idx = 0; idx < n; idx++)
+			{
+				out[idx] = arr[idx];
+			}
+
+			arr.DropFront(n);
+
+			return n;
+		}
+};
+
+// Pushes items [first, first + count) in batches, retrying while the queue is full
+template <typename queue_type>
+void produce(queue_type & queue, long first, long count, int batch)
+{
+	vector<long> buf(batch);
+
+	for (long sent = 0; sent < count; )
+	{
+		int const n = static_cast<int>(min(static_cast<long>(batch), count - sent));
+
+		for (int idx = 0; idx < n; idx++)
+		{
+			buf[idx] = first + sent + idx;
+		}
+
+		int added = 0;
+
+		while (added < n)
+		{
+			int const count_added = queue.TryAppendRange(buf.data() + added, n - added);
+
+			if (count_added == 0)
+			{
+				this_thread::yield();
+			}
+
+			added += count_added;
+		}
+
+		sent += n;
+	}
+}
+
+// Pops count items in batches, retrying while the queue is empty, and adds them to the sum
+template <typename queue_type>
+void consume(queue_type & queue, long count, int batch, atomic<long long> & sum)
+{
+	vector<long> buf(batch);
+	long long    local_sum = 0;
+
+	for (long received = 0; received < count; )
+	{
+		int const n = static_cast<int>(min(static_cast<long>(batch), count - received));
+		int const count_taken = queue.TryDelFrontRange(buf.data(), n);
+
+		if (count_taken == 0)
+		{
+			this_thread::yield();
+		}
+
+		for (int idx = 0; idx < count_taken; idx++)
+		{
+			local_sum += buf[idx];
+		}
+
+		received += count_taken;
+	}
+
+	sum += local_sum;
+}
+
+// Runs threads producers and threads consumers over one queue, and prints the throughput
+template <typename queue_type>
+void run_benchmark(const char * name, int threads, int batch, long items)
+{
+	queue_type        queue_obj;
+	atomic<long long> sum(0);
+	vector<thread>    workers;
+
+	long const per_thread = items / threads;
+	long const total      = per_thread * threads;
+
+	auto const start = chrono::steady_clock::now();
+
+	for (int idx = 0; idx < threads; idx++)
+	{
+		workers.push_back(thread(produce<queue_type>, ref(queue_obj), idx * per_thread, per_thread, batch));
+		workers.push_back(thread(consume<queue_type>, ref(queue_obj), per_thread, batch, ref(sum)));
+	}
+
+	for (size_t idx = 0; idx < workers.size(); idx++)
+	{
+		workers[idx].join();
+	}
+
+	double const seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	// Every item was received exactly once if the sum matches
+	bool const b_ok = (sum.load() == (static_cast<long long>(total) * (total - 1)) / 2);
+
+	cout << left  << setw(8)  << name
+	     << right << setw(10) << threads
+	     << setw(11) << threads
+	     << setw(8)  << batch
+	     << setw(14) << fixed << setprecision(2) << (total / seconds / 1e6)
+	     << (b_ok ? "" : "  CHECKSUM MISMATCH") << endl;
+}
+
+// MpmcCDA with the benchmark's capacity
+class MpmcQueue : public MpmcCDA<long>
+{
+	public:
+
+		MpmcQueue() : MpmcCDA<long>(queue_capacity)
+		{
+		}
+};
+
+int main(int argc, char * argv[]) {
+
+	// The number of items sent through each queue, which can be given as the first argument
+	long const items = (argc > 1) ? atol(argv[1]) : 4000000;
+
+	int const thread_counts[] = {1, 2, 4, 8, 16};
+	int const batches[]       = {1, 32};
+
+	cout << "Queue    Producers  Consumers   Batch  Million items/s" << endl;
+
+	for (int batch : batches)
+	{
+		for (int threads : thread_counts)
+		{
+			run_benchmark<MpmcQueue>("mpmc", threads, batch, items);
+			run_benchmark<LockedCDA>("mutex", threads, batch, items);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "SpscCDA.cpp"
+
+// The capacity of the queue, kept small so the indexes wrap around often
+const int queue_capacity = 8;
+
+// The item for a sequence number. It is long enough to live on the heap, so the sanitizer sees every
+// read and write of its contents.
+string make_item(long seq)
+{
+	return "spsc stress item number " + to_string(seq);
+}
+
+// Adds count items in order, switching between single, emplaced and bulk adds
+void produce(SpscCDA<string> & queue, long count)
+{
+	vector<string> buf;
+
+	for (long seq = 0; seq < count; )
+	{
+		int const mode = static_cast<int>(seq % 3);
+
+		if (mode == 0)
+		{
+			if (queue.TryAddEnd(make_item(seq)))
+			{
+				seq++;
+			}
+		}
+		else if (mode == 1)
+		{
+			if (queue.TryEmplaceEnd(make_item(seq)))
+			{
+				seq++;
+			}
+		}
+		else
+		{
+			buf.clear();
+
+			for (long idx = seq; (idx < count) && (idx < seq + 5); idx++)
+			{
+				buf.push_back(make_item(idx));
+			}
+
+			seq += queue.AppendRange(buf.data(), static_cast<int>(buf.size()));
+		}
+
+		this_thread::yield();
+	}
+}
+
+// Deletes count items, switching between single and bulk deletes, and checks they come out in order
+bool consume(SpscCDA<string> & queue, long count)
+{
+	string buf[6];
+	bool   b_ok = true;
+
+	for (long seq = 0; seq < count; )
+	{
+		int const length = queue.Length();
+
+		b_ok = b_ok && (length >= 0) && (length <= queue_capacity);
+
+		if (seq % 2)
+		{
+			if (queue.TryDelFront(buf[0]))
+			{
+				b_ok = b_ok && (buf[0] == make_item(seq));
+				seq++;
+			}
+			else
+			{
+				this_thread::yield();
+			}
+		}
+		else
+		{
+			int const taken = queue.DelFrontRange(buf, 6);
+
+			for (int idx = 0; idx < taken; idx++)
+			{
+				b_ok = b_ok && (buf[idx] == make_item(seq + idx));
+			}
+
+			seq += taken;
+
+			if (taken == 0)
+			{
+				this_thread::yield();
+			}
+		}
+	}
+
+	return b_ok;
+}
+
+int main(int argc, char * argv[]) {
+
+	// The number of items sent through the queue, which can be given as the first argument
+	long const items = (argc > 1) ? atol(argv[1]) : 100000;
+
+	SpscCDA<string> queue(queue_capacity);
+	bool            b_ok = false;
+
+	thread producer(produce, ref(queue), items);
+	thread consumer([&]() { b_ok = consume(queue, items); });
+
+	producer.join();
+	consumer.join();
+
+	b_ok = b_ok && (queue.Length() == 0);
+
+	cout << "SpscCDA stress: " << items << " items " << (b_ok ? "passed" : "FAILED") << endl;
+
+	return b_ok ? 0 : 1;
+}
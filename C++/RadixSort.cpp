@@ -0,0 +1,232 @@
+/**
+ * @file RadixSort.cpp
+ *
+ * This file implements the LSD radix sort used by the circular dynamic array for integral and
+ * floating point element types.
+ *
+ * Each element is mapped to an unsigned key of the same size whose unsigned order matches the order
+ * of the element, and the keys are then sorted 8 bits per pass, starting with the lowest byte.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for RadixSort.cpp
+#ifndef RADIX_SORT_CPP
+#define RADIX_SORT_CPP
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * The unsigned integer type with the given size in bytes.
+ */
+template <int size>
+struct UnsignedOfSize;
+
+template <> struct UnsignedOfSize<1> { typedef unsigned char      type; };
+template <> struct UnsignedOfSize<2> { typedef unsigned short     type; };
+template <> struct UnsignedOfSize<4> { typedef unsigned int       type; };
+template <> struct UnsignedOfSize<8> { typedef unsigned long long type; };
+
+/**
+ * Which key transform an element type uses: 0 if it can't be radix sorted, 1 for integral types,
+ * and 2 for floating point types.
+ */
+template <typename elmtype>
+struct RadixCategory
+{
+    static const int size = sizeof(elmtype);
+
+    static const bool b_size_ok = (size == 1) || (size == 2) || (size == 4) || (size == 8);
+
+    static const int value = (!b_size_ok || is_same<elmtype, bool>::value) ? 0 :
+                             is_integral<elmtype>::value                   ? 1 :
+                             (is_floating_point<elmtype>::value && (size >= 4)) ? 2 : 0;
+};
+
+/**
+ * Maps an element to an unsigned key that sorts in the same order. Types that can't be radix sorted
+ * have #b_sortable set to false.
+ */
+template <typename elmtype, int category = RadixCategory<elmtype>::value>
+struct RadixKey
+{
+    static const bool b_sortable = false;
+};
+
+/**
+ * Integral keys. Signed types have their sign bit flipped so that negative values come first.
+ */
+template <typename elmtype>
+struct RadixKey<elmtype, 1>
+{
+    typedef typename UnsignedOfSize<sizeof(elmtype)>::type key_type;
+
+    static const bool b_sortable = true;
+
+    static key_type Get(elmtype e)
+    {
+        key_type const sign_bit = static_cast<key_type>(key_type(1) << (8 * sizeof(elmtype) - 1));
+
+        key_type const key = static_cast<key_type>(e);
+
+        return is_signed<elmtype>::value ? static_cast<key_type>(key ^ sign_bit) : key;
+    }
+};
+
+/**
+ * Floating point keys. Negative values have all of their bits flipped so that they sort in reverse,
+ * and positive values have their sign bit set so that they come after the negative values.
+ */
+template <typename elmtype>
+struct RadixKey<elmtype, 2>
+{
+    typedef typename UnsignedOfSize<sizeof(elmtype)>::type key_type;
+
+    static const bool b_sortable = true;
+
+    static key_type Get(elmtype e)
+    {
+        key_type const sign_bit = static_cast<key_type>(key_type(1) << (8 * sizeof(elmtype) - 1));
+
+        key_type bits;
+        memcpy(&bits, &e, sizeof(bits));
+
+        return (bits & sign_bit) ? static_cast<key_type>(~bits) : static_cast<key_type>(bits | sign_bit);
+    }
+};
+
+/**
+ * LSD radix sort, 8 bits per pass.
+ */
+template <typename elmtype>
+struct RadixSorter
+{
+    static_assert(RadixKey<elmtype>::b_sortable, "RadixSort requires an integral or floating point type");
+
+    typedef RadixKey<elmtype> key;
+
+    static const int passes = sizeof(elmtype); ///< One pass per byte of the key.
+    static const int radix  = 256;             ///< Number of buckets per pass.
+
+    /**
+     * Gets the digit of an element that is used for the given pass.
+     */
+    static int Digit(elmtype const & e, int pass)
+    {
+        return static_cast<int>((key::Get(e) >> (8 * pass)) & 0xFF);
+    }
+
+    /**
+     * Counts the digits of every pass for a segment.
+     */
+    static void Histogram(elmtype const * seg, int seg_len, int counts[][radix])
+    {
+        for (int idx = 0; idx < seg_len; idx++)
+        {
+            typename key::key_type const k = key::Get(seg[idx]);
+
+            for (int pass = 0; pass < passes; pass++)
+            {
+                counts[pass][(k >> (8 * pass)) & 0xFF]++;
+            }
+        }
+    }
+
+    /**
+     * Moves the elements of a segment into their buckets for the given pass.
+     */
+    static void Scatter(elmtype const * seg, int seg_len, int pass, int * offsets, elmtype * dest)
+    {
+        for (int idx = 0; idx < seg_len; idx++)
+        {
+            dest[offsets[Digit(seg[idx], pass)]++] = seg[idx];
+        }
+    }
+
+    /**
+     * Sorts the elements held in two segments. The passes alternate between the scratch array and the
+     * start of the data array, and the sorted elements always end up at the start of the data array.
+     *
+     * @param[in]     first      The start of the first segment.
+     * @param[in]     first_len  The number of elements in the first segment.
+     * @param[in]     second     The start of the second segment.
+     * @param[in]     second_len The number of elements in the second segment.
+     * @param[in,out] data       The array that holds both segments, with room for all of the elements.
+     * @param[in]     scratch    A scratch array with room for all of the elements.
+     *
+     * @retval true  The sorted elements were written to the start of #data.
+     * @retval false Every element has the same key, so nothing was moved.
+     */
+    static bool Sort(elmtype * first, int first_len, elmtype * second, int second_len,
+                     elmtype * data, elmtype * scratch)
+    {
+        int const n = first_len + second_len;
+
+        if (n < 2)
+        {
+            return false;
+        }
+
+        int counts[passes][radix];
+        memset(counts, 0, sizeof(counts));
+
+        // Count the digits for every pass at once
+        Histogram(first, first_len, counts);
+        Histogram(second, second_len, counts);
+
+        elmtype const * src1     = first;
+        int             src1_len = first_len;
+        elmtype const * src2     = second;
+        int             src2_len = second_len;
+        elmtype       * dest     = scratch;
+        bool            b_moved  = false;
+
+        for (int pass = 0; pass < passes; pass++)
+        {
+            int * const count = counts[pass];
+
+            // Skip the pass if every element has the same digit, since it wouldn't move anything
+            elmtype const & sample = (src1_len > 0) ? src1[0] : src2[0];
+
+            if (count[Digit(sample, pass)] == n)
+            {
+                continue;
+            }
+
+            // Turn the counts into the starting offset of each bucket
+            int offset = 0;
+
+            for (int digit = 0; digit < radix; digit++)
+            {
+                int const digit_count = count[digit];
+                count[digit] = offset;
+                offset += digit_count;
+            }
+
+            Scatter(src1, src1_len, pass, count, dest);
+            Scatter(src2, src2_len, pass, count, dest);
+
+            // The output of this pass is the input of the next one
+            src1     = dest;
+            src1_len = n;
+            src2_len = 0;
+            dest     = (dest == scratch) ? data : scratch;
+            b_moved  = true;
+        }
+
+        // Make sure the sorted elements end up in the data array
+        if (b_moved && (src1 == scratch))
+        {
+            copy(scratch, scratch + n, data);
+        }
+
+        return b_moved;
+    }
+};
+
+// End of include guard for RADIX_SORT_CPP
+#endif
@@ -0,0 +1,278 @@
+/**
+ * @file SearchIndex.cpp
+ *
+ * This file implements the searches used on sorted arrays: a branchless binary search that works on
+ * any random access accessor, and a read optimized Eytzinger index for arrays that are searched far
+ * more often than they are changed.
+ *
+ * The branchless search halves the range with a conditional move instead of a branch, so it never
+ * mispredicts, and always takes exactly ceil(log2 N) + 1 probes. The Eytzinger index stores a copy
+ * of the sorted elements in breadth first order, so the first levels of every search share a few
+ * cache lines, and the grandchildren four levels down are prefetched while the current level is
+ * compared.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for SearchIndex.cpp
+#ifndef SEARCH_INDEX_CPP
+#define SEARCH_INDEX_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Returns true if an element comes before the bound being searched for, which is the first element
+ * not less than e for a lower bound, or the first element greater than e for an upper bound.
+ *
+ * @tparam b_upper True for an upper bound.
+ */
+template <bool b_upper, typename elmtype>
+inline bool BeforeBound(const elmtype & elm, const elmtype & e)
+{
+    return b_upper ? !(e < elm) : (elm < e);
+}
+
+/**
+ * Branchless binary search for a bound in a sorted range.
+ *
+ * @tparam b_upper True to find the upper bound, false to find the lower bound.
+ *
+ * @param[in] get An accessor called as get(idx) that returns the element at idx of the range.
+ * @param[in] n   The number of elements in the range.
+ * @param[in] e   The value to search for.
+ *
+ * @return The index of the first element not less than e for a lower bound, or greater than e for
+ *         an upper bound, or n if there is no such element.
+ */
+template <bool b_upper, typename accessor, typename elmtype>
+int BranchlessBound(accessor get, int n, const elmtype & e)
+{
+    if (n <= 0)
+    {
+        return 0;
+    }
+
+    // The bound is always within [base, base + n]
+    int base = 0;
+
+    while (n > 1)
+    {
+        int const half = n / 2;
+
+        base += BeforeBound<b_upper>(get(base + half - 1), e) ? half : 0;
+        n    -= half;
+    }
+
+    return base + (BeforeBound<b_upper>(get(base), e) ? 1 : 0);
+}
+
+/**
+ * Read optimized search index over a sorted range. The elements are copied into an array in
+ * breadth first (Eytzinger) order: the root is at index 1 and the children of index k are at 2k and
+ * 2k + 1. Every search then walks down from the root with no branches to mispredict, and its next
+ * few levels are prefetched.
+ *
+ * @note The index is a copy, so it has to be built again after the array it was built from changes.
+ */
+template <typename elmtype>
+
+class EytzingerIndex
+{
+    private:
+
+        static const int cache_line = 64; ///< The size of a cache line in bytes.
+
+        /// The descendants of node k four levels down start at node k * #prefetch_stride, and fill one
+        /// cache line for elements of 4 bytes.
+        static const unsigned prefetch_stride = 16;
+
+        void *    raw_tree  = NULL; ///< The storage of the #tree, with room to align it.
+        elmtype * tree      = NULL; ///< The elements in breadth first order, starting at index 1.
+        int *     ranks     = NULL; ///< The index in the sorted range of each node, with #tree_size at index 0.
+        int       tree_size = 0;    ///< The number of elements in the index.
+
+        /**
+         * Copies the sorted elements into the subtree rooted at node k, in order.
+         *
+         * @param[in,out] it   The next sorted element to copy.
+         * @param[in,out] rank The index in the sorted range of it.
+         * @param[in]     k    The root of the subtree.
+         */
+        template <typename iter>
+        void Fill(iter & it, int & rank, int k)
+        {
+            if (k <= tree_size)
+            {
+                Fill(it, rank, 2 * k);
+
+                ::new (static_cast<void *>(tree + k)) elmtype(*it);
+                ranks[k] = rank;
+
+                ++it;
+                rank++;
+
+                Fill(it, rank, 2 * k + 1);
+            }
+        }
+
+        /**
+         * Walks down the tree to a bound.
+         *
+         * @tparam b_upper True to find the upper bound, false to find the lower bound.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The index of the bound in the sorted range.
+         */
+        template <bool b_upper>
+        int Bound(const elmtype & e) const
+        {
+            unsigned const n = static_cast<unsigned>(tree_size);
+            unsigned       k = 1;
+
+            while (k <= n)
+            {
+                // The address is only a hint, so it is computed as an integer to allow it past the end
+                __builtin_prefetch(reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(tree) +
+                                                                  k * prefetch_stride * sizeof(elmtype)));
+
+                k = 2 * k + (BeforeBound<b_upper>(tree[k], e) ? 1 : 0);
+            }
+
+            // Every right turn after the last left turn is undone, along with the left turn itself.
+            // If there was no left turn, k is 0 and the bound is past the end.
+            k >>= __builtin_ffs(~k);
+
+            return ranks[k];
+        }
+
+    public:
+
+        EytzingerIndex()
+        {
+        }
+
+        /**
+         * Constructor that builds the index over a sorted range.
+         *
+         * @param[in] first The start of the sorted range.
+         * @param[in] last  The end of the sorted range.
+         */
+        template <typename iter>
+        EytzingerIndex(iter first, iter last)
+        {
+            Build(first, last);
+        }
+
+        /**
+         * Destructor, which frees the index.
+         */
+        ~EytzingerIndex()
+        {
+            Free();
+        }
+
+        EytzingerIndex(const EytzingerIndex &) = delete;
+        EytzingerIndex& operator=(const EytzingerIndex &) = delete;
+
+        /**
+         * Builds the index over a sorted range, replacing anything it held before. For a #CDA, pass
+         * its cbegin() and cend() after it has been sorted.
+         *
+         * @param[in] first The start of the sorted range.
+         * @param[in] last  The end of the sorted range.
+         *
+         * @note Takes O(N) time, reading the range once in order.
+         */
+        template <typename iter>
+        void Build(iter first, iter last)
+        {
+            Free();
+
+            tree_size = static_cast<int>(last - first);
+
+            // Align the tree so that the nodes prefetched together share a cache line
+            raw_tree = ::operator new((tree_size + 1) * sizeof(elmtype) + cache_line);
+            tree     = reinterpret_cast<elmtype *>((reinterpret_cast<uintptr_t>(raw_tree) + cache_line - 1) &
+                                                   ~static_cast<uintptr_t>(cache_line - 1));
+            ranks    = new int[tree_size + 1];
+
+            ranks[0] = tree_size;
+
+            int rank = 0;
+
+            Fill(first, rank, 1);
+        }
+
+        /**
+         * Frees the index, leaving it empty.
+         */
+        void Free()
+        {
+            for (int k = 1; k <= tree_size; k++)
+            {
+                tree[k].~elmtype();
+            }
+
+            ::operator delete(raw_tree);
+            delete[] ranks;
+
+            raw_tree  = NULL;
+            tree      = NULL;
+            ranks     = NULL;
+            tree_size = 0;
+        }
+
+        /**
+         * Returns the number of elements in the index.
+         */
+        int Length() const
+        {
+            return tree_size;
+        }
+
+        /**
+         * Finds the first element that is not less than e.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The index of the element in the sorted range, or #Length() if there is none.
+         */
+        int LowerBound(const elmtype & e) const
+        {
+            return Bound<false>(e);
+        }
+
+        /**
+         * Finds the first element that is greater than e.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The index of the element in the sorted range, or #Length() if there is none.
+         */
+        int UpperBound(const elmtype & e) const
+        {
+            return Bound<true>(e);
+        }
+
+        /**
+         * Finds the elements equal to e.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The indexes in the sorted range of the first element equal to e and of the element
+         *         just past the last one, which are equal if there is no such element.
+         */
+        pair<int, int> EqualRange(const elmtype & e) const
+        {
+            return make_pair(Bound<false>(e), Bound<true>(e));
+        }
+};
+
+// End of include guard for SEARCH_INDEX_CPP
+#endif
@@ -0,0 +1,983 @@
+/**
+ * @file SegmentedCDA.cpp
+ *
+ * This file implements a segmented version of the circular dynamic array.
+ *
+ * The elements are stored in fixed size blocks, and a small circular directory holds a pointer to
+ * each block. Adding an element at either end only ever allocates a new block, so existing elements
+ * are never moved, and the block and offset of an index are found with a shift and a mask. When the
+ * directory fills up it is doubled, which only copies one pointer per block.
+ *
+ * Indexes are checked by an error policy, as in the #CDA. The default is #AssertOnError, the same
+ * policy the #Heap gives its array, so a heap built on a SegmentedCDA only checks them in debug builds.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for SegmentedCDA.cpp
+#ifndef SEGMENTED_CDA_CPP
+#define SEGMENTED_CDA_CPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ErrorPolicy.cpp"
+#include "IntroSelect.cpp"
+#include "MergeSort.cpp"
+#include "RadixSort.cpp"
+#include "SimdScan.cpp"
+
+using namespace std;
+
+template <typename elmtype, int block_shift = 10, typename error_policy = AssertOnError>
+
+class SegmentedCDA
+{
+    static_assert(alignof(elmtype) <= alignof(max_align_t), "SegmentedCDA storage is not aligned for this type");
+
+    private:
+
+        static const int block_size = 1 << block_shift; ///< The number of elements in each block.
+        static const int block_mask = block_size - 1;   ///< Mask for the offset of an element in its block.
+
+        int user_size    = 0;         ///< The number of elements that the user has access to.
+        int front_offset = 0;         ///< The offset of the front element in the first block.
+
+        int dir_capacity = 0;         ///< The number of pointers the #blocks directory has room for, always a power of two.
+        int dir_front    = 0;         ///< The index of the #blocks directory that points to the first block.
+        int dir_size     = 0;         ///< The number of blocks in use.
+
+        bool b_init = false;          ///< Used to signal that unallocated blocks hold the #init_val.
+        elmtype init_val;             ///< The value that the array should be initialized to.
+
+        elmtype ref_val;              ///< Reference value returned when the #error_policy rejects an index
+
+        elmtype ** blocks      = NULL; ///< Circular directory of block pointers. A block is NULL until it is used if #b_init is set.
+        elmtype *  spare_block = NULL; ///< A freed block that is kept for the next block that is needed.
+
+        /**
+         * Returns the index of the #blocks directory for a block number, where block 0 is the first
+         * block.
+         */
+        int DirIdx(int block_num)
+        {
+            return (dir_front + block_num) & (dir_capacity - 1);
+        }
+
+        /**
+         * Returns raw storage for a block, reusing the #spare_block if there is one.
+         */
+        elmtype * AllocateBlock()
+        {
+            if (NULL != spare_block)
+            {
+                elmtype * block = spare_block;
+                spare_block = NULL;
+
+                return block;
+            }
+
+            return static_cast<elmtype *>(::operator new(block_size * sizeof(elmtype)));
+        }
+
+        /**
+         * Frees a block whose elements have already been destroyed, keeping it as the #spare_block if
+         * there isn't one already.
+         */
+        void ReleaseBlock(elmtype * block)
+        {
+            if (NULL == spare_block)
+            {
+                spare_block = block;
+            }
+            else
+            {
+                ::operator delete(static_cast<void *>(block));
+            }
+        }
+
+        /**
+         * Gets the part of a block that holds elements.
+         *
+         * @param[in]  block_num The block number.
+         * @param[out] start     Set to the offset of the first element in the block.
+         * @param[out] end       Set to the offset just past the last element in the block.
+         */
+        void LiveRange(int block_num, int & start, int & end)
+        {
+            int const block_start = block_num << block_shift;
+
+            start = max(front_offset, block_start) - block_start;
+            end   = min(front_offset + user_size, block_start + block_size) - block_start;
+        }
+
+        /**
+         * Destroys the elements of a block in the range [start, end).
+         */
+        static void DestroyRange(elmtype * block, int start, int end)
+        {
+            if (!is_trivially_destructible<elmtype>::value)
+            {
+                for (int idx = start; idx < end; idx++)
+                {
+                    block[idx].~elmtype();
+                }
+            }
+        }
+
+        /**
+         * Returns a block, allocating it first if it was left NULL by the init constructor.
+         *
+         * @param[in] block_num The block number.
+         *
+         * @return A pointer to the start of the block.
+         */
+        elmtype * Block(int block_num)
+        {
+            elmtype *& block = blocks[DirIdx(block_num)];
+
+            if (NULL == block)
+            {
+                int start;
+                int end;
+
+                LiveRange(block_num, start, end);
+
+                // The elements of an unallocated block all hold the init value
+                block = AllocateBlock();
+
+                for (int idx = start; idx < end; idx++)
+                {
+                    ::new (static_cast<void *>(block + idx)) elmtype(init_val);
+                }
+            }
+
+            return block;
+        }
+
+        /**
+         * Returns a pointer to the element at an index of the array.
+         */
+        elmtype * Slot(int idx)
+        {
+            int const pos = front_offset + idx;
+
+            return Block(pos >> block_shift) + (pos & block_mask);
+        }
+
+        /**
+         * Doubles the #blocks directory. Only the block pointers are copied, the blocks stay where
+         * they are.
+         */
+        void GrowDirectory()
+        {
+            int const new_dir_capacity = max(4, 2 * dir_capacity);
+
+            elmtype ** new_blocks = new elmtype*[new_dir_capacity];
+
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                new_blocks[block_num] = blocks[DirIdx(block_num)];
+            }
+
+            delete[] blocks;
+
+            blocks       = new_blocks;
+            dir_capacity = new_dir_capacity;
+            dir_front    = 0;
+        }
+
+        /**
+         * Adds a new block after the last block.
+         */
+        void PushBlockBack()
+        {
+            if (dir_size == dir_capacity)
+            {
+                GrowDirectory();
+            }
+
+            blocks[DirIdx(dir_size)] = AllocateBlock();
+            dir_size++;
+        }
+
+        /**
+         * Adds a new block before the first block.
+         */
+        void PushBlockFront()
+        {
+            if (dir_size == dir_capacity)
+            {
+                GrowDirectory();
+            }
+
+            dir_front = (dir_front - 1 + dir_capacity) & (dir_capacity - 1);
+            blocks[dir_front] = AllocateBlock();
+            dir_size++;
+        }
+
+        /**
+         * Creates a directory with room for a number of blocks, all of them NULL.
+         *
+         * @param[in] block_count The number of blocks.
+         */
+        void CreateDirectory(int block_count)
+        {
+            dir_capacity = 4;
+
+            while (dir_capacity < block_count)
+            {
+                dir_capacity <<= 1;
+            }
+
+            blocks    = new elmtype*[dir_capacity];
+            dir_front = 0;
+            dir_size  = block_count;
+
+            for (int block_num = 0; block_num < block_count; block_num++)
+            {
+                blocks[block_num] = NULL;
+            }
+        }
+
+        /**
+         * Destroys every element and frees all of the blocks and the directory.
+         */
+        void FreeBlocks()
+        {
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                elmtype * block = blocks[DirIdx(block_num)];
+
+                if (NULL != block)
+                {
+                    int start;
+                    int end;
+
+                    LiveRange(block_num, start, end);
+                    DestroyRange(block, start, end);
+
+                    ::operator delete(static_cast<void *>(block));
+                }
+            }
+
+            delete[] blocks;
+            ::operator delete(static_cast<void *>(spare_block));
+
+            blocks      = NULL;
+            spare_block = NULL;
+        }
+
+        /**
+         * Copies the blocks and attributes of another SegmentedCDA object.
+         *
+         * @param[in] obj_being_copied The SegmentedCDA object to copy.
+         *
+         * @note Any prior blocks must already have been freed.
+         */
+        void CopyBlocks(const SegmentedCDA & obj_being_copied)
+        {
+            user_size    = obj_being_copied.user_size;
+            front_offset = obj_being_copied.front_offset;
+
+            b_init   = obj_being_copied.b_init;
+            init_val = obj_being_copied.init_val;
+            ref_val  = obj_being_copied.ref_val;
+
+            CreateDirectory(obj_being_copied.dir_size);
+
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                elmtype const * src_block = obj_being_copied.blocks[(obj_being_copied.dir_front + block_num) &
+                                                                    (obj_being_copied.dir_capacity - 1)];
+
+                // Blocks that are still unallocated stay that way
+                if (NULL != src_block)
+                {
+                    int start;
+                    int end;
+
+                    LiveRange(block_num, start, end);
+
+                    blocks[block_num] = AllocateBlock();
+                    uninitialized_copy(src_block + start, src_block + end, blocks[block_num] + start);
+                }
+            }
+        }
+
+        /**
+         * Takes the blocks and attributes of another SegmentedCDA object, leaving it empty.
+         *
+         * @param[in] obj_being_moved The SegmentedCDA object to take the blocks from.
+         */
+        void TakeBlocks(SegmentedCDA & obj_being_moved)
+        {
+            user_size    = obj_being_moved.user_size;
+            front_offset = obj_being_moved.front_offset;
+
+            dir_capacity = obj_being_moved.dir_capacity;
+            dir_front    = obj_being_moved.dir_front;
+            dir_size     = obj_being_moved.dir_size;
+
+            b_init   = obj_being_moved.b_init;
+            init_val = move(obj_being_moved.init_val);
+
+            blocks      = obj_being_moved.blocks;
+            spare_block = obj_being_moved.spare_block;
+
+            // Leave the other object as an empty array that can still be used
+            obj_being_moved.user_size    = 0;
+            obj_being_moved.front_offset = 0;
+            obj_being_moved.dir_capacity = 0;
+            obj_being_moved.dir_front    = 0;
+            obj_being_moved.dir_size     = 0;
+            obj_being_moved.b_init       = false;
+            obj_being_moved.blocks       = NULL;
+            obj_being_moved.spare_block  = NULL;
+        }
+
+        /**
+         * Allocates every block that is still NULL, so that the array no longer needs to be treated
+         * as initialized.
+         */
+        void InsertInitValues()
+        {
+            if (!b_init)
+            {
+                return;
+            }
+
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                Block(block_num);
+            }
+
+            b_init = false;
+        }
+
+        /**
+         * Moves every element into a new plain array, in order. The array is raw storage that the
+         * elements are move constructed into, so no element is ever default constructed.
+         *
+         * @return The plain array, which must be freed with BottomUpMergeSorter::FreeScratch().
+         */
+        elmtype * MoveOut()
+        {
+            elmtype * dest = static_cast<elmtype *>(::operator new(user_size * sizeof(elmtype)));
+            elmtype * next = dest;
+
+            ForEach([&next](elmtype & elm)
+            {
+                ::new (static_cast<void *>(next++)) elmtype(move(elm));
+            });
+
+            return dest;
+        }
+
+        /**
+         * Moves the elements of a plain array back into the array, in order.
+         */
+        void MoveIn(elmtype * src)
+        {
+            ForEach([&src](elmtype & elm)
+            {
+                elm = move(*src++);
+            });
+        }
+
+        /**
+         * Sorts a plain array of an integral or floating point type with the radix sort. The scratch
+         * array is raw storage, which is fine for these types.
+         */
+        static void SortImpl(elmtype * data, int n, true_type)
+        {
+            elmtype * scratch = static_cast<elmtype *>(::operator new(n * sizeof(elmtype)));
+
+            RadixSorter<elmtype>::Sort(data, n, data, 0, data, scratch);
+
+            ::operator delete(static_cast<void *>(scratch));
+        }
+
+        /**
+         * Sorts a plain array of any other type with the merge sort.
+         */
+        static void SortImpl(elmtype * data, int n, false_type)
+        {
+            BottomUpMergeSorter<elmtype>::SortInPlace(data, n);
+        }
+
+    public:
+
+        /**
+         * The default constructor, creates an empty array. No blocks are allocated until an element is
+         * added.
+         */
+        SegmentedCDA(void)
+        {
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s.
+         *
+         * @param[in] s The number of elements in the array.
+         */
+        SegmentedCDA(int s)
+        {
+            int const block_count = (s + block_mask) >> block_shift;
+
+            CreateDirectory(block_count);
+
+            for (int block_num = 0; block_num < block_count; block_num++)
+            {
+                blocks[block_num] = AllocateBlock();
+            }
+
+            user_size = s;
+
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                ::new (static_cast<void *>(Slot(idx))) elmtype;
+            }
+        }
+
+        /**
+         * Constructor that creates an array of #user_size s that acts as though it has been
+         * initialized with the value init. Only the directory is created, and each block is allocated
+         * and filled the first time one of its elements is used.
+         *
+         * @param[in] s    The number of elements in the array.
+         * @param[in] init The value that the array should act as though it has been initialized with.
+         *
+         * @note Takes O(s / block size) time.
+         */
+        SegmentedCDA(int s, elmtype init)
+        {
+            b_init   = true;
+            init_val = init;
+
+            CreateDirectory((s + block_mask) >> block_shift);
+
+            user_size = s;
+        }
+
+        /**
+         * Copy constructor for the SegmentedCDA class.
+         *
+         * @param[in] obj_being_copied A reference to a SegmentedCDA object that should be used to
+         *                             create a new SegmentedCDA object.
+         */
+        SegmentedCDA(const SegmentedCDA & obj_being_copied)
+        {
+            CopyBlocks(obj_being_copied);
+        }
+
+        /**
+         * Move constructor for the SegmentedCDA class.
+         *
+         * @param[in] obj_being_moved A SegmentedCDA object whose blocks should be used to create a new
+         *                            SegmentedCDA object. It is left empty.
+         */
+        SegmentedCDA(SegmentedCDA && obj_being_moved) noexcept
+        {
+            TakeBlocks(obj_being_moved);
+        }
+
+        /**
+         * Copy Assignment operator.
+         *
+         * @param[in] obj_being_copied A reference to a SegmentedCDA object that is going to be copied
+         *                             over.
+         *
+         * @return A reference to an updated SegmentedCDA object that matches #obj_being_copied.
+         */
+        SegmentedCDA& operator=(const SegmentedCDA & obj_being_copied)
+        {
+            if (this != &obj_being_copied)
+            {
+                FreeBlocks();
+                CopyBlocks(obj_being_copied);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Move Assignment operator.
+         *
+         * @param[in] obj_being_moved A SegmentedCDA object whose blocks should be moved over. It is left
+         *                            empty.
+         *
+         * @return A reference to an updated SegmentedCDA object that matches what #obj_being_moved
+         *         was.
+         */
+        SegmentedCDA& operator=(SegmentedCDA && obj_being_moved) noexcept
+        {
+            if (this != &obj_being_moved)
+            {
+                FreeBlocks();
+                TakeBlocks(obj_being_moved);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Destructor for the SegmentedCDA class.
+         */
+        ~SegmentedCDA()
+        {
+            FreeBlocks();
+        }
+
+        /**
+         * Returns the size of the array.
+         *
+         * @return The size of the array that the user has access to.
+         */
+        int Length()
+        {
+            return user_size;
+        }
+
+        /**
+         * Returns the capacity of the array.
+         *
+         * @return The number of elements the blocks in use have room for.
+         */
+        int Capacity()
+        {
+            return dir_size * block_size;
+        }
+
+        /**
+         * Overload version of the [] operator for the SegmentedCDA class. The index is checked by the
+         * #error_policy.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to the element, or to #ref_val if the #error_policy rejects the index.
+         */
+        elmtype &operator[](int idx)
+        {
+            if (!error_policy::InBounds(idx, user_size)) //< If the idx is out of the accesible range.
+            {
+                return ref_val;
+            }
+
+            return *Slot(idx);
+        }
+
+        /**
+         * Checked accessor that always checks the index, whatever the #error_policy is.
+         *
+         * @param[in] idx The index of the array that the user wants to access.
+         *
+         * @return A reference to the element.
+         *
+         * @throws out_of_range The index is out of bounds.
+         */
+        elmtype &At(int idx)
+        {
+            ThrowOnError::InBounds(idx, user_size);
+
+            return *Slot(idx);
+        }
+
+        /**
+         * Adds an element to the back of the array.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         *
+         * @note Never moves the existing elements.
+         */
+        void AddEnd(const elmtype & data_val)
+        {
+            EmplaceEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the array.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array.
+         */
+        void AddEnd(elmtype && data_val)
+        {
+            EmplaceEnd(move(data_val));
+        }
+
+        /**
+         * Constructs an element from the given arguments in place at the back of the array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         */
+        template <typename... arg_types>
+        void EmplaceEnd(arg_types &&... args)
+        {
+            int const pos = front_offset + user_size;
+
+            // Start a new block if the last one is full
+            if ((pos >> block_shift) == dir_size)
+            {
+                PushBlockBack();
+            }
+
+            ::new (static_cast<void *>(Block(pos >> block_shift) + (pos & block_mask))) elmtype(forward<arg_types>(args)...);
+
+            user_size++;
+        }
+
+        /**
+         * Adds an element to the front of the array.
+         *
+         * @param[in] v The data element to be added to the front of the array.
+         *
+         * @note Never moves the existing elements.
+         */
+        void AddFront(const elmtype & v)
+        {
+            EmplaceFront(v);
+        }
+
+        /**
+         * Moves an element to the front of the array.
+         *
+         * @param[in] v The data element to be moved to the front of the array.
+         */
+        void AddFront(elmtype && v)
+        {
+            EmplaceFront(move(v));
+        }
+
+        /**
+         * Constructs an element from the given arguments in place at the front of the array.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         */
+        template <typename... arg_types>
+        void EmplaceFront(arg_types &&... args)
+        {
+            // Start a new block if the first one is full
+            if (front_offset == 0)
+            {
+                PushBlockFront();
+                front_offset = block_size;
+            }
+
+            ::new (static_cast<void *>(Block(0) + (front_offset - 1))) elmtype(forward<arg_types>(args)...);
+
+            front_offset--;
+            user_size++;
+        }
+
+        /**
+         * Deletes the back element of the array. The last block is released once it is empty.
+         */
+        void DelEnd()
+        {
+            // If the array is empty, don't do anything
+            if (user_size == 0)
+            {
+                return;
+            }
+
+            int const pos       = front_offset + user_size - 1;
+            int const block_num = pos >> block_shift;
+
+            elmtype * block = blocks[DirIdx(block_num)];
+
+            if (NULL != block)
+            {
+                block[pos & block_mask].~elmtype();
+            }
+
+            user_size--;
+
+            // The deleted element was the first one in the last block
+            if ((pos & block_mask) == 0)
+            {
+                if (NULL != block)
+                {
+                    ReleaseBlock(block);
+                }
+
+                dir_size--;
+            }
+        }
+
+        /**
+         * Deletes the front element of the array. The first block is released once it is empty.
+         */
+        void DelFront()
+        {
+            // If the array is empty, don't do anything
+            if (user_size == 0)
+            {
+                return;
+            }
+
+            elmtype * block = blocks[dir_front];
+
+            if (NULL != block)
+            {
+                block[front_offset].~elmtype();
+            }
+
+            front_offset++;
+            user_size--;
+
+            // The deleted element was the last one in the first block
+            if (front_offset == block_size)
+            {
+                if (NULL != block)
+                {
+                    ReleaseBlock(block);
+                }
+
+                dir_front    = (dir_front + 1) & (dir_capacity - 1);
+                front_offset = 0;
+                dir_size--;
+            }
+        }
+
+        /**
+         * Calls the visitor once for each block of the array, in order.
+         *
+         * @param[in] visit A function or functor called as visit(seg, seg_len, start), where seg
+         *                  points to seg_len elements, and start is the index of seg[0] in the array.
+         *
+         * @note If the array was initialized with a value, every block is allocated first.
+         */
+        template <typename visitor>
+        void ForEachSegment(visitor visit)
+        {
+            InsertInitValues();
+
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                int start;
+                int end;
+
+                LiveRange(block_num, start, end);
+
+                if (start < end)
+                {
+                    visit(blocks[DirIdx(block_num)] + start, end - start,
+                          (block_num << block_shift) + start - front_offset);
+                }
+            }
+        }
+
+        /**
+         * Calls the visitor once for each element of the array, in order.
+         *
+         * @param[in] visit A function or functor called as visit(elm) with a reference to each element.
+         *
+         * @note If the array was initialized with a value, every block is allocated first.
+         */
+        template <typename visitor>
+        void ForEach(visitor visit)
+        {
+            ForEachSegment([&visit](elmtype * seg, int seg_len, int)
+            {
+                for (int idx = 0; idx < seg_len; idx++)
+                {
+                    visit(seg[idx]);
+                }
+            });
+        }
+
+        /**
+         * Performs a linear search of the array looking for the specified item.
+         *
+         * @param[in] e The elmtype value to look for in the array.
+         *
+         * @return The index of the item if found, or -1 if the item was not in the array.
+         */
+        int Search(elmtype e)
+        {
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                elmtype const * block = blocks[DirIdx(block_num)];
+
+                int start;
+                int end;
+
+                LiveRange(block_num, start, end);
+
+                int const block_idx = (block_num << block_shift) + start - front_offset;
+
+                if (NULL == block)
+                {
+                    // Every element of an unallocated block holds the init value
+                    if ((start < end) && (e == init_val))
+                    {
+                        return block_idx;
+                    }
+                }
+                else
+                {
+                    int const idx = SimdScan<elmtype>::Find(block + start, end - start, e);
+
+                    if (idx >= 0)
+                    {
+                        return block_idx + idx;
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        /**
+         * Counts the number of elements in the array that are equal to the specified item.
+         *
+         * @param[in] e The elmtype value to count in the array.
+         *
+         * @return The number of elements equal to e.
+         */
+        int Count(elmtype e)
+        {
+            int count = 0;
+
+            for (int block_num = 0; block_num < dir_size; block_num++)
+            {
+                elmtype const * block = blocks[DirIdx(block_num)];
+
+                int start;
+                int end;
+
+                LiveRange(block_num, start, end);
+
+                if (NULL == block)
+                {
+                    count += (e == init_val) ? (end - start) : 0;
+                }
+                else
+                {
+                    count += SimdScan<elmtype>::Count(block + start, end - start, e);
+                }
+            }
+
+            return count;
+        }
+
+        /**
+         * Performs a binary search on a sorted array looking for item e.
+         *
+         * @param[in] e The elmtype value to look for in the array.
+         *
+         * @return The index of the item if found, otherwise a negative number that is the bitwise
+         *         complement of the index of the next element that is larger than e or, if there is
+         *         no larger element, the bitwise complement of size.
+         */
+        int BinSearch(elmtype e)
+        {
+            int lower_bound = 0;
+            int upper_bound = user_size;
+
+            while (lower_bound < upper_bound)
+            {
+                int const mid = lower_bound + ((upper_bound - lower_bound) / 2);
+
+                if (*Slot(mid) < e)
+                {
+                    lower_bound = mid + 1;
+                }
+                else
+                {
+                    upper_bound = mid;
+                }
+            }
+
+            if ((lower_bound < user_size) && (*Slot(lower_bound) == e))
+            {
+                return lower_bound;
+            }
+
+            return ~lower_bound;
+        }
+
+        /**
+         * Sorts the array. The elements are moved into one contiguous array, sorted there with the
+         * radix sort for integral and floating point types or the merge sort otherwise, and moved back,
+         * so each element is moved out and in once on top of the moves the sort makes.
+         */
+        void Sort()
+        {
+            if (user_size < 2)
+            {
+                return;
+            }
+
+            elmtype * data = MoveOut();
+
+            SortImpl(data, user_size, integral_constant<bool, RadixKey<elmtype>::b_sortable>());
+            MoveIn(data);
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(data, user_size);
+        }
+
+        /**
+         * Function that selects the kth smallest element in the array.
+         *
+         * @note Afterwards, the kth smallest element is at index k - 1, with no larger element before it
+         *       and no smaller element after it.
+         *
+         * @param[in] k An integer signaling which smallest element the user is looking for.
+         *
+         * @return The kth smallest element in the array, or #ref_val if the #error_policy rejects k.
+         */
+        elmtype Select(int k)
+        {
+            if (!error_policy::InBounds(k - 1, user_size))
+            {
+                return ref_val;
+            }
+
+            elmtype * data = MoveOut();
+
+            IntroSelector<elmtype> selector(static_cast<unsigned>(user_size) ^ static_cast<unsigned>(k));
+            selector.Select(data, 0, user_size, k - 1);
+
+            MoveIn(data);
+
+            BottomUpMergeSorter<elmtype>::FreeScratch(data, user_size);
+
+            return *Slot(k - 1);
+        }
+
+        /*********************************
+         * Debug Functions
+         *********************************/
+
+        /**
+         * Displays information regarding the blocks of the array.
+         */
+        void ArrayCheck()
+        {
+            cout << "Front Offset: "       << front_offset << endl;
+            cout << "User Size: "          << user_size    << endl;
+            cout << "Blocks: "             << dir_size     << endl;
+            cout << "Directory Capacity: " << dir_capacity << endl;
+        }
+
+        /**
+         * Displays the contents of the array.
+         */
+        void DisplayArrayContents()
+        {
+            for (int idx = 0; idx < user_size; idx++)
+            {
+                cout << *Slot(idx) << " ";
+            }
+
+            cout << endl;
+        }
+};
+
+// End of include guard for SEGMENTED_CDA_CPP
+#endif
@@ -0,0 +1,419 @@
+/**
+ * @file SimdScan.cpp
+ *
+ * This file implements the vectorized linear scans used by the circular dynamic array to search
+ * contiguous segments of arithmetic element types.
+ *
+ * The vector width is chosen at compile time: AVX2 is used when the compiler targets it (for
+ * example with -mavx2 or -march=native), SSE2 is used on any other x86-64 build, and a scalar loop
+ * is used everywhere else.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for SimdScan.cpp
+#ifndef SIMD_SCAN_CPP
+#define SIMD_SCAN_CPP
+
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Bits of a byte comparison mask that are kept so that each lane of size bytes contributes a single
+ * bit. Every byte of a lane compares the same way, so only the lowest byte of each lane is needed.
+ */
+template <int size>
+struct LaneBits;
+
+template <> struct LaneBits<1> { static const unsigned value = 0xFFFFFFFFu; };
+template <> struct LaneBits<2> { static const unsigned value = 0x55555555u; };
+template <> struct LaneBits<4> { static const unsigned value = 0x11111111u; };
+template <> struct LaneBits<8> { static const unsigned value = 0x01010101u; };
+
+#if defined(__SSE2__)
+
+/**
+ * SSE2 comparisons for lanes of size bytes, holding either integer or floating point elements.
+ */
+template <typename elmtype, int size = sizeof(elmtype), bool b_float = is_floating_point<elmtype>::value>
+struct Sse2Lanes;
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 1, false>
+{
+    static __m128i Splat(elmtype e)           { return _mm_set1_epi8(static_cast<char>(e)); }
+    static __m128i Eq(__m128i a, __m128i b)   { return _mm_cmpeq_epi8(a, b); }
+};
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 2, false>
+{
+    static __m128i Splat(elmtype e)           { return _mm_set1_epi16(static_cast<short>(e)); }
+    static __m128i Eq(__m128i a, __m128i b)   { return _mm_cmpeq_epi16(a, b); }
+};
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 4, false>
+{
+    static __m128i Splat(elmtype e)           { return _mm_set1_epi32(static_cast<int>(e)); }
+    static __m128i Eq(__m128i a, __m128i b)   { return _mm_cmpeq_epi32(a, b); }
+};
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 8, false>
+{
+    static __m128i Splat(elmtype e)           { return _mm_set1_epi64x(static_cast<long long>(e)); }
+
+    // SSE2 has no 64 bit compare, so both 32 bit halves of a lane must match.
+    static __m128i Eq(__m128i a, __m128i b)
+    {
+        __m128i const halves = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+};
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 4, true>
+{
+    static __m128i Splat(elmtype e)           { return _mm_castps_si128(_mm_set1_ps(e)); }
+    static __m128i Eq(__m128i a, __m128i b)
+    {
+        return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+};
+
+template <typename elmtype>
+struct Sse2Lanes<elmtype, 8, true>
+{
+    static __m128i Splat(elmtype e)           { return _mm_castpd_si128(_mm_set1_pd(e)); }
+    static __m128i Eq(__m128i a, __m128i b)
+    {
+        return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+};
+
+/**
+ * Vector operations on 16 byte registers.
+ */
+template <typename elmtype>
+struct Sse2Ops
+{
+    typedef __m128i vec;
+
+    static const int lanes = 16 / sizeof(elmtype); ///< Number of elements per register.
+
+    static vec Splat(elmtype e)
+    {
+        return Sse2Lanes<elmtype>::Splat(e);
+    }
+
+    /**
+     * Compares a register's worth of elements against the key.
+     *
+     * @return A mask with one bit set for each element that is equal to the key.
+     */
+    static unsigned EqMask(elmtype const * arr, vec key)
+    {
+        vec const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(arr));
+        unsigned const bytes = static_cast<unsigned>(_mm_movemask_epi8(Sse2Lanes<elmtype>::Eq(data, key)));
+
+        return bytes & LaneBits<sizeof(elmtype)>::value;
+    }
+};
+
+#endif // __SSE2__
+
+#if defined(__AVX2__)
+
+/**
+ * AVX2 comparisons for lanes of size bytes, holding either integer or floating point elements.
+ */
+template <typename elmtype, int size = sizeof(elmtype), bool b_float = is_floating_point<elmtype>::value>
+struct Avx2Lanes;
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 1, false>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_set1_epi8(static_cast<char>(e)); }
+    static __m256i Eq(__m256i a, __m256i b)   { return _mm256_cmpeq_epi8(a, b); }
+};
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 2, false>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_set1_epi16(static_cast<short>(e)); }
+    static __m256i Eq(__m256i a, __m256i b)   { return _mm256_cmpeq_epi16(a, b); }
+};
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 4, false>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_set1_epi32(static_cast<int>(e)); }
+    static __m256i Eq(__m256i a, __m256i b)   { return _mm256_cmpeq_epi32(a, b); }
+};
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 8, false>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_set1_epi64x(static_cast<long long>(e)); }
+    static __m256i Eq(__m256i a, __m256i b)   { return _mm256_cmpeq_epi64(a, b); }
+};
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 4, true>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_castps_si256(_mm256_set1_ps(e)); }
+    static __m256i Eq(__m256i a, __m256i b)
+    {
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    }
+};
+
+template <typename elmtype>
+struct Avx2Lanes<elmtype, 8, true>
+{
+    static __m256i Splat(elmtype e)           { return _mm256_castpd_si256(_mm256_set1_pd(e)); }
+    static __m256i Eq(__m256i a, __m256i b)
+    {
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    }
+};
+
+/**
+ * Vector operations on 32 byte registers.
+ */
+template <typename elmtype>
+struct Avx2Ops
+{
+    typedef __m256i vec;
+
+    static const int lanes = 32 / sizeof(elmtype); ///< Number of elements per register.
+
+    static vec Splat(elmtype e)
+    {
+        return Avx2Lanes<elmtype>::Splat(e);
+    }
+
+    /**
+     * Compares a register's worth of elements against the key.
+     *
+     * @return A mask with one bit set for each element that is equal to the key.
+     */
+    static unsigned EqMask(elmtype const * arr, vec key)
+    {
+        vec const data = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(arr));
+        unsigned const bytes = static_cast<unsigned>(_mm256_movemask_epi8(Avx2Lanes<elmtype>::Eq(data, key)));
+
+        return bytes & LaneBits<sizeof(elmtype)>::value;
+    }
+};
+
+#endif // __AVX2__
+
+/**
+ * Scalar scan, used for element types that can't be compared with vector instructions.
+ */
+template <typename elmtype, bool b_vectorize>
+struct ScanImpl
+{
+    static int Find(elmtype const * arr, int len, elmtype const & e)
+    {
+        for (int idx = 0; idx < len; idx++)
+        {
+            if (e == arr[idx])
+            {
+                return idx;
+            }
+        }
+
+        return -1;
+    }
+
+    static int Count(elmtype const * arr, int len, elmtype const & e)
+    {
+        int count = 0;
+
+        for (int idx = 0; idx < len; idx++)
+        {
+            if (e == arr[idx])
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    template <typename visitor>
+    static void ForEachMatch(elmtype const * arr, int len, elmtype const & e, visitor & visit)
+    {
+        for (int idx = 0; idx < len; idx++)
+        {
+            if (e == arr[idx])
+            {
+                visit(idx);
+            }
+        }
+    }
+};
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+/**
+ * Vector scan, which compares two registers worth of elements per loop and finishes the last few
+ * elements with the scalar scan.
+ */
+template <typename elmtype>
+struct ScanImpl<elmtype, true>
+{
+#if defined(__AVX2__)
+    typedef Avx2Ops<elmtype> ops;
+#else
+    typedef Sse2Ops<elmtype> ops;
+#endif
+
+    static const int size  = sizeof(elmtype);  ///< Number of mask bits per element.
+    static const int lanes = ops::lanes;       ///< Number of elements per register.
+    static const int step  = 2 * ops::lanes;   ///< Number of elements compared per loop.
+
+    static int Find(elmtype const * arr, int len, elmtype const & e)
+    {
+        typename ops::vec const key = ops::Splat(e);
+
+        int idx = 0;
+
+        for (; idx + step <= len; idx += step)
+        {
+            unsigned const lo = ops::EqMask(arr + idx, key);
+            unsigned const hi = ops::EqMask(arr + idx + lanes, key);
+
+            if (0 != lo)
+            {
+                return idx + (__builtin_ctz(lo) / size);
+            }
+            if (0 != hi)
+            {
+                return idx + lanes + (__builtin_ctz(hi) / size);
+            }
+        }
+
+        int const tail = ScanImpl<elmtype, false>::Find(arr + idx, len - idx, e);
+
+        return (tail < 0) ? -1 : (idx + tail);
+    }
+
+    static int Count(elmtype const * arr, int len, elmtype const & e)
+    {
+        typename ops::vec const key = ops::Splat(e);
+
+        int count = 0;
+        int idx   = 0;
+
+        for (; idx + step <= len; idx += step)
+        {
+            count += __builtin_popcount(ops::EqMask(arr + idx, key));
+            count += __builtin_popcount(ops::EqMask(arr + idx + lanes, key));
+        }
+
+        return count + ScanImpl<elmtype, false>::Count(arr + idx, len - idx, e);
+    }
+
+    template <typename visitor>
+    static void ForEachMatch(elmtype const * arr, int len, elmtype const & e, visitor & visit)
+    {
+        typename ops::vec const key = ops::Splat(e);
+
+        int idx = 0;
+
+        for (; idx + lanes <= len; idx += lanes)
+        {
+            unsigned mask = ops::EqMask(arr + idx, key);
+
+            // Visit each set bit, lowest index first
+            while (0 != mask)
+            {
+                visit(idx + (__builtin_ctz(mask) / size));
+                mask &= (mask - 1);
+            }
+        }
+
+        for (; idx < len; idx++)
+        {
+            if (e == arr[idx])
+            {
+                visit(idx);
+            }
+        }
+    }
+};
+
+#endif // __AVX2__ || __SSE2__
+
+/**
+ * Linear scans over a contiguous array. Arithmetic types that fit in a vector lane use the vector
+ * scan, all other types use the scalar scan.
+ */
+template <typename elmtype>
+struct SimdScan
+{
+    /// Whether the element type can be compared with vector instructions.
+    static const bool b_vectorize = is_arithmetic<elmtype>::value &&
+                                    !is_same<elmtype, bool>::value &&
+                                    !is_same<elmtype, long double>::value;
+
+    typedef ScanImpl<elmtype, b_vectorize> impl;
+
+    /**
+     * Finds the first element of the array that is equal to e.
+     *
+     * @param[in] arr The array to search.
+     * @param[in] len The number of elements in the array.
+     * @param[in] e   The value to look for.
+     *
+     * @return The index of the first match, or -1 if there isn't one.
+     */
+    static int Find(elmtype const * arr, int len, elmtype const & e)
+    {
+        return impl::Find(arr, len, e);
+    }
+
+    /**
+     * Counts the elements of the array that are equal to e.
+     *
+     * @param[in] arr The array to search.
+     * @param[in] len The number of elements in the array.
+     * @param[in] e   The value to look for.
+     *
+     * @return The number of matches.
+     */
+    static int Count(elmtype const * arr, int len, elmtype const & e)
+    {
+        return impl::Count(arr, len, e);
+    }
+
+    /**
+     * Calls visit(idx) for the index of every element of the array that is equal to e, in order.
+     *
+     * @param[in] arr   The array to search.
+     * @param[in] len   The number of elements in the array.
+     * @param[in] e     The value to look for.
+     * @param[in] visit The function or functor to call for each match.
+     */
+    template <typename visitor>
+    static void ForEachMatch(elmtype const * arr, int len, elmtype const & e, visitor & visit)
+    {
+        impl::ForEachMatch(arr, len, e, visit);
+    }
+};
+
+// End of include guard for SIMD_SCAN_CPP
+#endif
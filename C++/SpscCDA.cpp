@@ -0,0 +1,304 @@
+/**
+ * @file SpscCDA.cpp
+ *
+ * This file implements a fixed capacity version of the circular dynamic array that one producer
+ * thread and one consumer thread can use as a FIFO without any locks.
+ *
+ * The producer only ever writes #back_idx and the consumer only ever writes #front_idx. Both indexes
+ * count up forever and are wrapped with a mask when a slot is used, so the array is full when they
+ * are #arr_capacity apart. Each index is kept on its own cache line, next to the owning thread's
+ * cached copy of the other index, so the two threads only touch each other's cache line when the
+ * cached copy says the array looks full or empty.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for SpscCDA.cpp
+#ifndef SPSC_CDA_CPP
+#define SPSC_CDA_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+template <typename elmtype>
+
+class SpscCDA
+{
+    static_assert(alignof(elmtype) <= alignof(max_align_t), "SpscCDA storage is not aligned for this type");
+
+    private:
+
+        static const int cache_line = 64; ///< The size of a cache line in bytes.
+
+        // Set once by the constructor, and only read after that.
+        elmtype *      data_array   = NULL; ///< The raw storage where the elements are kept.
+        unsigned const arr_capacity;        ///< The capacity of the array, always a power of two.
+        unsigned const idx_mask;            ///< Mask that wraps an index into the #data_array.
+
+        // Written by the producer.
+        alignas(cache_line) atomic<unsigned> back_idx;  ///< The number of elements that have been added.
+        unsigned cached_front = 0;                       ///< The producer's last copy of #front_idx.
+
+        // Written by the consumer.
+        alignas(cache_line) atomic<unsigned> front_idx; ///< The number of elements that have been deleted.
+        unsigned cached_back = 0;                        ///< The consumer's last copy of #back_idx.
+
+        /**
+         * Rounds a capacity up to the next power of two.
+         */
+        static unsigned RoundCapacity(int s)
+        {
+            unsigned capacity = 1;
+
+            while (capacity < static_cast<unsigned>(max(1, s)))
+            {
+                capacity <<= 1;
+            }
+
+            return capacity;
+        }
+
+        /**
+         * Called by the producer. Returns how many elements can be added, looking at the consumer's
+         * index again only if the cached copy doesn't show room for n elements.
+         */
+        unsigned FreeSlots(unsigned back, unsigned n)
+        {
+            unsigned free_slots = arr_capacity - (back - cached_front);
+
+            if (free_slots < n)
+            {
+                cached_front = front_idx.load(memory_order_acquire);
+                free_slots   = arr_capacity - (back - cached_front);
+            }
+
+            return free_slots;
+        }
+
+        /**
+         * Called by the consumer. Returns how many elements can be deleted, looking at the producer's
+         * index again only if the cached copy doesn't show n elements.
+         */
+        unsigned UsedSlots(unsigned front, unsigned n)
+        {
+            unsigned used_slots = cached_back - front;
+
+            if (used_slots < n)
+            {
+                cached_back = back_idx.load(memory_order_acquire);
+                used_slots  = cached_back - front;
+            }
+
+            return used_slots;
+        }
+
+    public:
+
+        /**
+         * Constructor that creates an empty array with room for at least s elements.
+         *
+         * @param[in] s The number of elements the array needs room for, rounded up to the next power of
+         *              two.
+         */
+        SpscCDA(int s) : arr_capacity(RoundCapacity(s)), idx_mask(RoundCapacity(s) - 1),
+                         back_idx(0), front_idx(0)
+        {
+            data_array = static_cast<elmtype *>(::operator new(arr_capacity * sizeof(elmtype)));
+        }
+
+        /**
+         * Destructor, which destroys any elements that were never deleted.
+         *
+         * @note Neither thread can be using the array any more.
+         */
+        ~SpscCDA()
+        {
+            unsigned const back = back_idx.load(memory_order_acquire);
+
+            for (unsigned idx = front_idx.load(memory_order_acquire); idx != back; idx++)
+            {
+                data_array[idx & idx_mask].~elmtype();
+            }
+
+            ::operator delete(static_cast<void *>(data_array));
+        }
+
+        SpscCDA(const SpscCDA &) = delete;
+        SpscCDA& operator=(const SpscCDA &) = delete;
+
+        /**
+         * Returns the number of elements in the array. If either thread is using the array, the size
+         * may have changed by the time it is returned.
+         *
+         * @return The number of elements in the array.
+         */
+        int Length()
+        {
+            unsigned const front = front_idx.load(memory_order_acquire);
+            unsigned const back  = back_idx.load(memory_order_acquire);
+
+            return static_cast<int>(back - front);
+        }
+
+        /**
+         * Returns the capacity of the array.
+         *
+         * @return The number of elements the array has room for.
+         */
+        int Capacity()
+        {
+            return static_cast<int>(arr_capacity);
+        }
+
+        /**
+         * Constructs an element from the given arguments at the back of the array, if there is room.
+         * Must only be called by the producer.
+         *
+         * @param[in] args The arguments to pass to the elmtype constructor.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        template <typename... arg_types>
+        bool TryEmplaceEnd(arg_types &&... args)
+        {
+            unsigned const back = back_idx.load(memory_order_relaxed);
+
+            if (FreeSlots(back, 1) == 0)
+            {
+                return false;
+            }
+
+            ::new (static_cast<void *>(data_array + (back & idx_mask))) elmtype(forward<arg_types>(args)...);
+
+            // Publish the element to the consumer
+            back_idx.store(back + 1, memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * Adds an element to the back of the array, if there is room. Must only be called by the
+         * producer.
+         *
+         * @param[in] data_val The data element to be added to the end of the array.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        bool TryAddEnd(const elmtype & data_val)
+        {
+            return TryEmplaceEnd(data_val);
+        }
+
+        /**
+         * Moves an element to the back of the array, if there is room. Must only be called by the
+         * producer.
+         *
+         * @param[in] data_val The data element to be moved to the end of the array. It is left
+         *                     unchanged if the array was full.
+         *
+         * @retval true  The element was added.
+         * @retval false The array was full, so nothing was added.
+         */
+        bool TryAddEnd(elmtype && data_val)
+        {
+            return TryEmplaceEnd(move(data_val));
+        }
+
+        /**
+         * Moves the front element of the array out and deletes it, if there is one. Must only be
+         * called by the consumer.
+         *
+         * @param[out] out Set to the front element.
+         *
+         * @retval true  An element was deleted.
+         * @retval false The array was empty, so out was not changed.
+         */
+        bool TryDelFront(elmtype & out)
+        {
+            unsigned const front = front_idx.load(memory_order_relaxed);
+
+            if (UsedSlots(front, 1) == 0)
+            {
+                return false;
+            }
+
+            elmtype * elm = data_array + (front & idx_mask);
+
+            out = move(*elm);
+            elm->~elmtype();
+
+            // Hand the slot back to the producer
+            front_idx.store(front + 1, memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * Adds as many elements of a range as there is room for to the back of the array, in order.
+         * Must only be called by the producer.
+         *
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
+         *
+         * @return The number of elements that were added, starting with src[0].
+         *
+         * @note The elements are copied in at most two blocks and published to the consumer at once.
+         */
+        int AppendRange(const elmtype * src, int n)
+        {
+            unsigned const back  = back_idx.load(memory_order_relaxed);
+            unsigned const count = min(FreeSlots(back, static_cast<unsigned>(max(0, n))),
+                                       static_cast<unsigned>(max(0, n)));
+
+            unsigned const start     = back & idx_mask;
+            unsigned const first_len = min(count, arr_capacity - start);
+
+            uninitialized_copy(src, src + first_len, data_array + start);
+            uninitialized_copy(src + first_len, src + count, data_array);
+
+            back_idx.store(back + count, memory_order_release);
+
+            return static_cast<int>(count);
+        }
+
+        /**
+         * Moves up to n elements out of the front of the array and deletes them, in order. Must only
+         * be called by the consumer.
+         *
+         * @param[out] out The array to move the elements to, which must have room for n elements.
+         * @param[in]  n   The largest number of elements to delete.
+         *
+         * @return The number of elements that were deleted.
+         *
+         * @note The slots are handed back to the producer at once.
+         */
+        int DelFrontRange(elmtype * out, int n)
+        {
+            unsigned const front = front_idx.load(memory_order_relaxed);
+            unsigned const count = min(UsedSlots(front, static_cast<unsigned>(max(0, n))),
+                                       static_cast<unsigned>(max(0, n)));
+
+            for (unsigned idx = 0; idx < count; idx++)
+            {
+                elmtype * elm = data_array + ((front + idx) & idx_mask);
+
+                out[idx] = move(*elm);
+                elm->~elmtype();
+            }
+
+            front_idx.store(front + count, memory_order_release);
+
+            return static_cast<int>(count);
+        }
+};
+
+// End of include guard for SPSC_CDA_CPP
+#endif
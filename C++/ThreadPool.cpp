@@ -0,0 +1,167 @@
+/**
+ * @file ThreadPool.cpp
+ *
+ * This file implements a fixed size pool of worker threads, used by the parallel algorithms of the
+ * circular dynamic array.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for ThreadPool.cpp
+#ifndef THREAD_POOL_CPP
+#define THREAD_POOL_CPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool
+{
+    private:
+
+        vector<thread>           workers;      ///< The worker threads.
+        queue<function<void()> > tasks;        ///< Tasks that have been submitted but not started.
+
+        mutex              pool_mutex;         ///< Protects every member below.
+        condition_variable task_cv;            ///< Signaled when a task is submitted or the pool stops.
+        condition_variable done_cv;            ///< Signaled when the last pending task finishes.
+
+        int  pending_tasks = 0;                ///< Tasks that have been submitted but not finished.
+        bool b_stop        = false;            ///< Used to signal the workers to exit.
+
+        /**
+         * The loop run by each worker thread. Runs tasks until the pool is stopped.
+         */
+        void WorkerLoop()
+        {
+            while (true)
+            {
+                function<void()> task;
+
+                {
+                    unique_lock<mutex> lock(pool_mutex);
+
+                    // Wait until there is a task to run, or the pool is being destroyed
+                    while (!b_stop && tasks.empty())
+                    {
+                        task_cv.wait(lock);
+                    }
+
+                    if (tasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = tasks.front();
+                    tasks.pop();
+                }
+
+                task();
+
+                {
+                    unique_lock<mutex> lock(pool_mutex);
+
+                    pending_tasks--;
+
+                    if (pending_tasks == 0)
+                    {
+                        done_cv.notify_all();
+                    }
+                }
+            }
+        }
+
+    public:
+
+        /**
+         * Constructor that starts the worker threads.
+         *
+         * @param[in] threads The number of worker threads. If less than 1, the number of hardware
+         *                    threads is used.
+         */
+        ThreadPool(int threads)
+        {
+            if (threads < 1)
+            {
+                threads = static_cast<int>(thread::hardware_concurrency());
+            }
+            if (threads < 1)
+            {
+                threads = 1;
+            }
+
+            for (int idx = 0; idx < threads; idx++)
+            {
+                workers.push_back(thread(&ThreadPool::WorkerLoop, this));
+            }
+        }
+
+        /**
+         * Destructor, which finishes any submitted tasks and joins the worker threads.
+         */
+        ~ThreadPool()
+        {
+            {
+                unique_lock<mutex> lock(pool_mutex);
+                b_stop = true;
+            }
+
+            task_cv.notify_all();
+
+            for (size_t idx = 0; idx < workers.size(); idx++)
+            {
+                workers[idx].join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool& operator=(const ThreadPool &) = delete;
+
+        /**
+         * Returns the number of worker threads.
+         *
+         * @return The number of worker threads.
+         */
+        int Size()
+        {
+            return static_cast<int>(workers.size());
+        }
+
+        /**
+         * Adds a task to be run by one of the worker threads.
+         *
+         * @param[in] task The function to run.
+         */
+        void Submit(function<void()> task)
+        {
+            {
+                unique_lock<mutex> lock(pool_mutex);
+
+                tasks.push(task);
+                pending_tasks++;
+            }
+
+            task_cv.notify_one();
+        }
+
+        /**
+         * Blocks until every task that has been submitted has finished.
+         */
+        void Wait()
+        {
+            unique_lock<mutex> lock(pool_mutex);
+
+            while (pending_tasks > 0)
+            {
+                done_cv.wait(lock);
+            }
+        }
+};
+
+// End of include guard for THREAD_POOL_CPP
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @file TieredCDA.cpp
+ *
+ * This file implements a sorted tiered vector built from circular dynamic arrays.
+ *
+ * The elements are kept in sorted order in a directory of tiers. Each tier is a #CDA with room for
+ * exactly #tier_size elements, and every tier except the last is full, so the tier and offset of an
+ * index are found with a shift and a mask. Inserting an element shifts at most half of one tier,
+ * toward the nearer end of its circular buffer, and then moves one element between each pair of
+ * later tiers, from the back of one to the front of the next. Each of those moves is O(1) because
+ * the tiers are circular, so an insert or an erase moves O(#tier_size + N / #tier_size) elements.
+ *
+ * The #tier_size is doubled or halved as the array grows and shrinks, so that it stays close to the
+ * square root of N, and an insert or an erase moves O(sqrt(N)) elements. Changing the #tier_size
+ * moves every element once, and only happens after the size of the array has changed by a factor of
+ * four, so it adds O(1) amortized time to each operation.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for TieredCDA.cpp
+#ifndef TIERED_CDA_CPP
+#define TIERED_CDA_CPP
+
+#include <utility>
+
+#include "CDA.cpp"
+
+using namespace std;
+
+template <typename elmtype, typename error_policy = PrintOnError>
+
+class TieredCDA
+{
+    private:
+
+        typedef CDA<elmtype, PowerOfTwoCapacity, SplitInitTracker, UncheckedAccess> tier_type;
+        typedef CDA<tier_type, GeneralCapacity, SplitInitTracker, UncheckedAccess>  directory_type;
+
+        static const int min_tier_shift = 4; ///< The #tier_size is never halved below 1 << #min_tier_shift.
+
+        int user_size  = 0;                  ///< The number of elements that the user has access to.
+        int tier_shift = min_tier_shift;     ///< The log2 of the #tier_size.
+        int tier_size  = 1 << min_tier_shift; ///< The number of elements in every tier but the last.
+
+        directory_type tiers;                ///< The tiers, in order. Only the last one may not be full.
+
+        elmtype ref_val;                     ///< Reference value returned when the #error_policy rejects an index.
+
+        /**
+         * Returns a reference to the last element of a tier.
+         */
+        const elmtype &Back(int tier)
+        {
+            tier_type & t = tiers[tier];
+
+            return t[t.Length() - 1];
+        }
+
+        /**
+         * Finds the first tier whose last element is not before the bound being searched for.
+         *
+         * @tparam b_upper True to find the tier of the upper bound, false for the lower bound.
+         *
+         * @param[in] e The value to search for.
+         *
+         * @return The index of the tier, or the number of tiers if the bound is past the end.
+         */
+        template <bool b_upper>
+        int TierBound(const elmtype & e)
+        {
+            return BranchlessBound<b_upper>([this](int tier) -> const elmtype & { return Back(tier); },
+                                            tiers.Length(), e);
+        }
+
+        /**
+         * Finds a bound of the sorted array.
+         *
+         * @tparam b_upper True to find the upper bound, false to find the lower bound.
+         */
+        template <bool b_upper>
+        int Bound(const elmtype & e)
+        {
+            int const tier = TierBound<b_upper>(e);
+
+            if (tier == tiers.Length())
+            {
+                return user_size;
+            }
+
+            int const offset = b_upper ? tiers[tier].UpperBound(e) : tiers[tier].LowerBound(e);
+
+            return (tier << tier_shift) + offset;
+        }
+
+        /**
+         * Adds an empty tier to the back of the directory, with room for #tier_size elements.
+         */
+        void AddTier()
+        {
+            tiers.EmplaceEnd(0);
+            tiers[tiers.Length() - 1].Reserve(tier_size);
+        }
+
+        /**
+         * Moves every element into new tiers of size 1 << new_shift.
+         *
+         * @note Takes O(N) time.
+         */
+        void Retier(int new_shift)
+        {
+            directory_type old_tiers(move(tiers));
+
+            tier_shift = new_shift;
+            tier_size  = 1 << new_shift;
+
+            for (int tier = 0; tier < old_tiers.Length(); tier++)
+            {
+                tier_type & old_tier = old_tiers[tier];
+
+                for (int idx = 0; idx < old_tier.Length(); idx++)
+                {
+                    if ((tiers.Length() == 0) || (tiers[tiers.Length() - 1].Length() == tier_size))
+                    {
+                        AddTier();
+                    }
+
+                    tiers[tiers.Length() - 1].AddEnd(move(old_tier[idx]));
+                }
+            }
+        }
+
+        /**
+         * Doubles the #tier_size once the array holds more than 2 * #tier_size^2 elements, and halves
+         * it once the array holds fewer than #tier_size^2 / 8.
+         */
+        void Rebalance()
+        {
+            long long const squared = static_cast<long long>(tier_size) * tier_size;
+
+            if (user_size > (2 * squared))
+            {
+                Retier(tier_shift + 1);
+            }
+            else if ((tier_shift > min_tier_shift) && (user_size < (squared / 8)))
+            {
+                Retier(tier_shift - 1);
+            }
+        }
+
+    public:
+
+        /**
+         * The default constructor, creates an empty array.
+         */
+        TieredCDA() : tiers(0)
+        {
+        }
+
+        /**
+         * Returns the size of the array.
+         */
+        int Length()
+        {
+            return user_size;
+        }
+
+        /**
+         * Returns the number of elements in every tier but the last, which stays close to the square
+         * root of the size of the array.
+         */
+        int TierSize()
+        {
+            return tier_size;
+        }
+
+        /**
+         * Reads an element. The elements can't be changed in place, as that could break the order.
+         *
+         * @param[in] idx The index of the element to read.
+         *
+         * @return A const reference to the element, or to #ref_val if the #error_policy rejects the
+         *         index.
+         */
+        const elmtype &operator[](int idx)
+        {
+            if (!error_policy::InBounds(idx, user_size))
+            {
+                return ref_val;
+            }
+
+            return tiers[idx >> tier_shift][idx & (tier_size - 1)];
+        }
+
+        /**
+         * Inserts an element, keeping the array sorted.
+         *
+         * @param[in] e The element to insert. It goes after any elements equal to it.
+         *
+         * @return The index the element was inserted at.
+         *
+         * @note Moves O(sqrt(N)) elements.
+         */
+        int InsertSorted(elmtype e)
+        {
+            // The element goes into the first tier whose last element is greater than it
+            int const tier = TierBound<true>(e);
+            int       pos;
+
+            if (tier == tiers.Length())
+            {
+                // The element goes after every other one, at the back of the last tier
+                if ((tier == 0) || (tiers[tier - 1].Length() == tier_size))
+                {
+                    AddTier();
+                }
+
+                tiers[tiers.Length() - 1].AddEnd(move(e));
+                pos = user_size;
+            }
+            else
+            {
+                if (tiers[tier].Length() == tier_size)
+                {
+                    if (tiers[tiers.Length() - 1].Length() == tier_size)
+                    {
+                        AddTier();
+                    }
+
+                    // Make room by moving the last element of each full tier to the front of the next,
+                    // starting from the back
+                    for (int idx = tiers.Length() - 2; idx >= tier; idx--)
+                    {
+                        tier_type & from = tiers[idx];
+
+                        tiers[idx + 1].AddFront(move(from[tier_size - 1]));
+                        from.DelEnd();
+                    }
+                }
+
+                pos = (tier << tier_shift) + tiers[tier].InsertSorted(move(e));
+            }
+
+            user_size++;
+
+            Rebalance();
+
+            return pos;
+        }
+
+        /**
+         * Erases one element equal to e, keeping the array sorted.
+         *
+         * @param[in] e The value to erase.
+         *
+         * @retval true  An element equal to e was erased.
+         * @retval false There was no element equal to e.
+         *
+         * @note Moves O(sqrt(N)) elements.
+         */
+        bool EraseSorted(elmtype e)
+        {
+            // The first element equal to e can only be in the first tier whose last element is not less
+            int const tier = TierBound<false>(e);
+
+            if ((tier == tiers.Length()) || !tiers[tier].EraseSorted(e))
+            {
+                return false;
+            }
+
+            // Fill the gap by moving the first element of each later tier to the back of the one before
+            for (int idx = tier + 1; idx < tiers.Length(); idx++)
+            {
+                tier_type & from = tiers[idx];
+
+                tiers[idx - 1].AddEnd(move(from[0]));
+                from.DelFront();
+            }
+
+            if (tiers[tiers.Length() - 1].Length() == 0)
+            {
+                tiers.DelEnd();
+            }
+
+            user_size--;
+
+            Rebalance();
+
+            return true;
+        }
+
+        /**
+         * Finds the first element that is not less than e.
+         *
+         * @return The index of the element, or the size of the array if there is none.
+         */
+        int LowerBound(elmtype e)
+        {
+            return Bound<false>(e);
+        }
+
+        /**
+         * Finds the first element that is greater than e.
+         *
+         * @return The index of the element, or the size of the array if there is none.
+         */
+        int UpperBound(elmtype e)
+        {
+            return Bound<true>(e);
+        }
+
+        /**
+         * Performs a binary search looking for item e, first over the last element of each tier and
+         * then inside one tier.
+         *
+         * @param[in] e The elmtype value to look for in the array.
+         *
+         * @return The index of the first item equal to e if found, otherwise a negative number that is
+         *         the bitwise complement of the index of the next element that is larger than e or, if
+         *         there is no larger element, the bitwise complement of size.
+         */
+        int BinSearch(elmtype e)
+        {
+            int const idx = Bound<false>(e);
+
+            if ((idx < user_size) && !(e < tiers[idx >> tier_shift][idx & (tier_size - 1)]))
+            {
+                return idx;
+            }
+
+            return ~idx;
+        }
+};
+
+// End of include guard for TIERED_CDA_CPP
+#endif
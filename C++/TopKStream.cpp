@@ -0,0 +1,118 @@
+/**
+ * @file TopKStream.cpp
+ *
+ * This file implements a stream that keeps the k smallest elements added to it, without storing the
+ * whole stream.
+ *
+ * The candidates are kept in a #CDA with room for 2k elements. Once it is full, the kth smallest
+ * candidate is selected and the k larger ones are dropped, which takes O(k) time and happens at most
+ * once every k adds, so each add takes O(1) amortized time. The kth smallest candidate is then kept
+ * as a threshold, and any later element that is not smaller than it is rejected straight away.
+ *
+ * Written by: Andrew Hankins
+ */
+
+// Include guard for TopKStream.cpp
+#ifndef TOP_K_STREAM_CPP
+#define TOP_K_STREAM_CPP
+
+#include <algorithm>
+
+#include "CDA.cpp"
+
+using namespace std;
+
+template <typename elmtype>
+
+class TopKStream
+{
+    private:
+
+        int k;                      ///< The number of smallest elements to keep.
+        CDA<elmtype> candidates;    ///< The elements that may be among the k smallest, at most 2k.
+
+        bool    b_threshold = false; ///< Set once the #candidates have been cut down to k.
+        elmtype threshold;           ///< The kth smallest element when the #candidates were last cut down.
+
+        /**
+         * Cuts the #candidates down to the k smallest, and keeps the largest of them as the
+         * #threshold.
+         */
+        void Compact()
+        {
+            threshold   = candidates.Select(k);
+            b_threshold = true;
+
+            candidates.DropBack(candidates.Length() - k);
+        }
+
+    public:
+
+        /**
+         * Constructor that creates an empty stream.
+         *
+         * @param[in] top_k The number of smallest elements to keep.
+         */
+        TopKStream(int top_k) : k(max(0, top_k)), candidates(0)
+        {
+            candidates.Reserve(2 * k);
+        }
+
+        /**
+         * Adds an element to the stream. It is only kept if it may be among the k smallest.
+         *
+         * @param[in] e The element to add.
+         */
+        void AddEnd(elmtype e)
+        {
+            if ((k == 0) || (b_threshold && !(e < threshold)))
+            {
+                return;
+            }
+
+            candidates.AddEnd(move(e));
+
+            if (candidates.Length() >= (2 * k))
+            {
+                Compact();
+            }
+        }
+
+        /**
+         * Adds a range of elements to the stream.
+         *
+         * @param[in] src The elements to add.
+         * @param[in] n   The number of elements to add.
+         */
+        void AppendRange(const elmtype * src, int n)
+        {
+            for (int idx = 0; idx < n; idx++)
+            {
+                AddEnd(src[idx]);
+            }
+        }
+
+        /**
+         * Copies the k smallest elements added so far, in order.
+         *
+         * @param[out] out The array to copy the elements to, which must have room for k elements.
+         *
+         * @return The number of elements copied, which is less than k only if fewer than k elements
+         *         have been added.
+         */
+        int TopK(elmtype * out)
+        {
+            return candidates.TopK(k, out);
+        }
+
+        /**
+         * Returns the number of elements that would be copied by #TopK().
+         */
+        int Length()
+        {
+            return min(k, candidates.Length());
+        }
+};
+
+// End of include guard for TOP_K_STREAM_CPP
+#endif